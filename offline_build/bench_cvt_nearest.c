@@ -0,0 +1,140 @@
+#include <string.h>
+
+#include "mod_recomp.h"
+#include "host_bench.h"
+
+// Checks do_cvt_w_s_nearest and do_cvt_w_d_nearest against the lroundf/lround calls they replaced, which round halfway
+// cases away from zero, then times both over random values. Floats are checked over a stride of every bit pattern in
+// int32 range, and doubles at every half-integer and its neighbours in +/-HALF_RANGE, near the ends of int32 range and
+// at random values.
+
+#define FLOAT_STRIDE 61
+#define HALF_RANGE 50000
+#define RANDOM_CHECK_COUNT (1 << 20)
+#define VALUE_COUNT 4096
+#define ITERATIONS 4096
+
+static int mismatches;
+
+static void check_float(float val) {
+    int32_t fast = do_cvt_w_s_nearest(val);
+    int32_t ref = (int32_t)lroundf(val);
+
+    if (fast != ref && mismatches++ < 10) {
+        printf("  float mismatch at %.9g: %d, lroundf %d\n", val, fast, ref);
+    }
+}
+
+static void check_double(double val) {
+    int32_t fast = do_cvt_w_d_nearest(val);
+    int32_t ref = (int32_t)lround(val);
+
+    if (fast != ref && mismatches++ < 10) {
+        printf("  double mismatch at %.17g: %d, lround %d\n", val, fast, ref);
+    }
+}
+
+// Checks a double and the closest values either side of it.
+static void check_double_neighbours(double val) {
+    check_double(nextafter(val, -INFINITY));
+    check_double(val);
+    check_double(nextafter(val, INFINITY));
+}
+
+static float float_from_bits(uint32_t bits) {
+    float val;
+    memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+static int check_equivalence(uint32_t* random_state) {
+    // 0x4F000000 is 2^31, the first positive float out of int32 range. -2^31 itself is in range.
+    for (uint32_t bits = 0; bits < 0x4F000000; bits += FLOAT_STRIDE) {
+        check_float(float_from_bits(bits));
+        check_float(float_from_bits(bits | 0x80000000));
+    }
+    check_float(-2147483648.0f);
+    for (int32_t i = -HALF_RANGE; i < HALF_RANGE; i++) {
+        check_float(i + 0.5f);
+        check_float(nextafterf(i + 0.5f, -INFINITY));
+        check_float(nextafterf(i + 0.5f, INFINITY));
+    }
+
+    for (int32_t i = -HALF_RANGE; i < HALF_RANGE; i++) {
+        check_double_neighbours(i + 0.5);
+        check_double_neighbours(i);
+    }
+    for (int32_t i = 0; i < 1024; i++) {
+        check_double_neighbours(2147482623.5 + i);
+        check_double_neighbours(-2147483647.5 + i);
+    }
+    for (int i = 0; i < RANDOM_CHECK_COUNT; i++) {
+        double val = (double)(int32_t)bench_random(random_state) + (double)bench_random(random_state) / 4294967296.0;
+        check_double(val);
+    }
+
+    return mismatches;
+}
+
+static float float_values[VALUE_COUNT];
+static double double_values[VALUE_COUNT];
+
+int main(void) {
+    uint32_t random_state = 1;
+    int64_t sum;
+    double start;
+
+    int failures = check_equivalence(&random_state);
+    printf("bench_cvt_nearest: %d mismatches against lroundf/lround\n", failures);
+    if (failures != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Values in the range game code usually converts, e.g. positions and angles, with plenty of halfway cases.
+    for (int i = 0; i < VALUE_COUNT; i++) {
+        float_values[i] = (float)((int32_t)(bench_random(&random_state) % 20001) - 10000) / 2.0f;
+        double_values[i] = float_values[i];
+    }
+
+    sum = 0;
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < VALUE_COUNT; j++) {
+            sum += do_cvt_w_s_nearest(float_values[j]);
+        }
+    }
+    bench_report("do_cvt_w_s_nearest", start, (uint64_t)ITERATIONS * VALUE_COUNT);
+    bench_sink += sum;
+
+    sum = 0;
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < VALUE_COUNT; j++) {
+            sum += (int32_t)lroundf(float_values[j]);
+        }
+    }
+    bench_report("lroundf", start, (uint64_t)ITERATIONS * VALUE_COUNT);
+    bench_sink += sum;
+
+    sum = 0;
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < VALUE_COUNT; j++) {
+            sum += do_cvt_w_d_nearest(double_values[j]);
+        }
+    }
+    bench_report("do_cvt_w_d_nearest", start, (uint64_t)ITERATIONS * VALUE_COUNT);
+    bench_sink += sum;
+
+    sum = 0;
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < VALUE_COUNT; j++) {
+            sum += (int32_t)lround(double_values[j]);
+        }
+    }
+    bench_report("lround", start, (uint64_t)ITERATIONS * VALUE_COUNT);
+    bench_sink += sum;
+
+    return EXIT_SUCCESS;
+}
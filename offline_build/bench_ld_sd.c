@@ -0,0 +1,90 @@
+#include <string.h>
+
+#include "mod_recomp.h"
+#include "host_bench.h"
+
+// Compares LD/SD against the split 32-bit accesses they replaced, by copying doublewords between random 8-byte aligned
+// addresses the way recompiled matrix and Vtx copies do.
+
+#define COPY_COUNT 4096
+#define ITERATIONS 4096
+
+// LD and SD as they were before moving to a single 64-bit access.
+static inline uint64_t split_load_doubleword(uint8_t* rdram, gpr reg, gpr offset) {
+    uint64_t lo = (uint64_t)(uint32_t)MEM_W(reg, offset + 4);
+    uint64_t hi = (uint64_t)(uint32_t)MEM_W(reg, offset + 0);
+    return (lo << 0) | (hi << 32);
+}
+
+#define SPLIT_LD(offset, reg) \
+    split_load_doubleword(rdram, offset, reg)
+
+#define SPLIT_SD(val, offset, reg) { \
+    *(uint32_t*)(rdram + ((((reg) + (offset) + 4)) - 0xFFFFFFFF80000000)) = (uint32_t)((gpr)(val) >> 0); \
+    *(uint32_t*)(rdram + ((((reg) + (offset) + 0)) - 0xFFFFFFFF80000000)) = (uint32_t)((gpr)(val) >> 32); \
+}
+
+static gpr src_addrs[COPY_COUNT];
+static gpr dst_addrs[COPY_COUNT];
+
+// Each copy moves a 64-byte block (one Mtx) with constant offsets from a base register, as recompiled code does.
+static void copy_single(uint8_t* rdram) {
+    for (int i = 0; i < COPY_COUNT; i++) {
+        gpr src = src_addrs[i];
+        gpr dst = dst_addrs[i];
+        for (int j = 0; j < 64; j += 8) {
+            SD(LD(j, src), j, dst);
+        }
+    }
+}
+
+static void copy_split(uint8_t* rdram) {
+    for (int i = 0; i < COPY_COUNT; i++) {
+        gpr src = src_addrs[i];
+        gpr dst = dst_addrs[i];
+        for (int j = 0; j < 64; j += 8) {
+            SPLIT_SD(SPLIT_LD(j, src), j, dst);
+        }
+    }
+}
+
+int main(void) {
+    uint8_t* rdram_single = bench_alloc_rdram();
+    uint8_t* rdram_split = bench_alloc_rdram();
+    uint32_t random_state = 1;
+    double start;
+
+    // Sources in the first half, destinations in the second, so copies never overlap.
+    for (int i = 0; i < COPY_COUNT; i++) {
+        src_addrs[i] = BENCH_VRAM((bench_random(&random_state) % (BENCH_RDRAM_SIZE / 2 - 64)) & ~7u);
+        dst_addrs[i] = BENCH_VRAM(BENCH_RDRAM_SIZE / 2 + ((bench_random(&random_state) % (BENCH_RDRAM_SIZE / 2 - 64)) & ~7u));
+    }
+    for (int i = 0; i < BENCH_RDRAM_SIZE / 2; i++) {
+        rdram_single[i] = rdram_split[i] = (uint8_t)bench_random(&random_state);
+    }
+
+    copy_single(rdram_single);
+    copy_split(rdram_split);
+    if (memcmp(rdram_single, rdram_split, BENCH_RDRAM_SIZE) != 0) {
+        printf("bench_ld_sd: single and split LD/SD results differ\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("bench_ld_sd: LD + SD of a doubleword (%d copies of 64 bytes)\n", COPY_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        copy_single(rdram_single);
+    }
+    bench_report("single 64-bit access", start, (uint64_t)ITERATIONS * COPY_COUNT * 8);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        copy_split(rdram_split);
+    }
+    bench_report("split 32-bit accesses", start, (uint64_t)ITERATIONS * COPY_COUNT * 8);
+
+    free(rdram_single);
+    free(rdram_split);
+    return EXIT_SUCCESS;
+}
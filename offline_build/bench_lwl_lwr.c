@@ -0,0 +1,127 @@
+#include <string.h>
+
+#include "mod_recomp.h"
+#include "host_bench.h"
+
+// Checks do_lwl_lwr and do_swl_swr against the LWL/LWR and SWL/SWR pairs they fuse, then times both at each of the four
+// misalignments. A pair accesses the unaligned word starting at `address`, with the LWL/SWL at `address` and the LWR/SWR
+// at `address + 3`.
+
+#define CHECK_COUNT (1 << 16)
+#define ACCESS_COUNT 4096
+#define ITERATIONS 4096
+
+static gpr addrs[ACCESS_COUNT];
+
+static int check_equivalence(uint8_t* rdram_pair, uint8_t* rdram_fused, uint32_t* random_state) {
+    int failures = 0;
+
+    for (uint32_t misalignment = 0; misalignment < 4; misalignment++) {
+        for (int i = 0; i < CHECK_COUNT; i++) {
+            // Starts a word in, so the 16 bytes compared around the access stay inside RDRAM.
+            uint32_t offset = 4 + ((bench_random(random_state) % (BENCH_RDRAM_SIZE - 16)) & ~3u) + misalignment;
+            gpr address = BENCH_VRAM(offset);
+            gpr initial = ((gpr)bench_random(random_state) << 32) | bench_random(random_state);
+            uint32_t value = bench_random(random_state);
+            uint8_t* rdram;
+
+            // Loads start from any previous register value and must fully replace it.
+            rdram = rdram_pair;
+            gpr pair = do_lwr(rdram, do_lwl(rdram, initial, 0, address), 3, address);
+            rdram = rdram_fused;
+            gpr fused = do_lwl_lwr(rdram, 0, address);
+            if (pair != fused) {
+                if (failures++ < 10) {
+                    printf("  load mismatch at misalignment %u: pair 0x%016llX fused 0x%016llX\n", misalignment,
+                           (unsigned long long)pair, (unsigned long long)fused);
+                }
+            }
+
+            // Stores must leave the surrounding bytes alone.
+            rdram = rdram_pair;
+            do_swl(rdram, 0, address, value);
+            do_swr(rdram, 3, address, value);
+            rdram = rdram_fused;
+            do_swl_swr(rdram, 0, address, value);
+            if (memcmp(rdram_pair + (offset & ~3u) - 4, rdram_fused + (offset & ~3u) - 4, 16) != 0) {
+                if (failures++ < 10) {
+                    printf("  store mismatch at misalignment %u, value 0x%08X\n", misalignment, value);
+                }
+            }
+        }
+    }
+
+    return failures;
+}
+
+static void load_pairs(uint8_t* rdram, gpr misalignment) {
+    uint64_t sum = 0;
+    for (int i = 0; i < ACCESS_COUNT; i++) {
+        sum += do_lwr(rdram, do_lwl(rdram, sum, misalignment, addrs[i]), misalignment + 3, addrs[i]);
+    }
+    bench_sink += sum;
+}
+
+static void load_fused(uint8_t* rdram, gpr misalignment) {
+    uint64_t sum = 0;
+    for (int i = 0; i < ACCESS_COUNT; i++) {
+        sum += do_lwl_lwr(rdram, misalignment, addrs[i]);
+    }
+    bench_sink += sum;
+}
+
+static void store_pairs(uint8_t* rdram, gpr misalignment) {
+    for (int i = 0; i < ACCESS_COUNT; i++) {
+        do_swl(rdram, misalignment, addrs[i], addrs[i]);
+        do_swr(rdram, misalignment + 3, addrs[i], addrs[i]);
+    }
+}
+
+static void store_fused(uint8_t* rdram, gpr misalignment) {
+    for (int i = 0; i < ACCESS_COUNT; i++) {
+        do_swl_swr(rdram, misalignment, addrs[i], addrs[i]);
+    }
+}
+
+static void time_accesses(const char* name, void (*func)(uint8_t*, gpr), uint8_t* rdram, gpr misalignment) {
+    char label[64];
+    double start = bench_now_ns();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        func(rdram, misalignment);
+    }
+    snprintf(label, sizeof(label), "%s, misalignment %u", name, (unsigned)misalignment);
+    bench_report(label, start, (uint64_t)ITERATIONS * ACCESS_COUNT);
+}
+
+int main(void) {
+    uint8_t* rdram_pair = bench_alloc_rdram();
+    uint8_t* rdram_fused = bench_alloc_rdram();
+    uint32_t random_state = 1;
+
+    for (int i = 0; i < BENCH_RDRAM_SIZE; i++) {
+        rdram_pair[i] = rdram_fused[i] = (uint8_t)bench_random(&random_state);
+    }
+
+    int failures = check_equivalence(rdram_pair, rdram_fused, &random_state);
+    printf("bench_lwl_lwr: %d mismatches in %d checks per misalignment\n", failures, CHECK_COUNT);
+    if (failures != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Word-aligned bases, with the misalignment applied as the instruction's offset.
+    for (int i = 0; i < ACCESS_COUNT; i++) {
+        addrs[i] = BENCH_VRAM(4 + ((bench_random(&random_state) % (BENCH_RDRAM_SIZE - 16)) & ~3u));
+    }
+
+    for (gpr misalignment = 0; misalignment < 4; misalignment++) {
+        time_accesses("LWL + LWR", load_pairs, rdram_pair, misalignment);
+        time_accesses("fused load", load_fused, rdram_fused, misalignment);
+        time_accesses("SWL + SWR", store_pairs, rdram_pair, misalignment);
+        time_accesses("fused store", store_fused, rdram_fused, misalignment);
+    }
+
+    free(rdram_pair);
+    free(rdram_fused);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+#include <stdarg.h>
+#include <string.h>
+
+#include "mod_recomp.h"
+#include "host_bench.h"
+
+// Checks rdram_read_bytes, rdram_write_bytes, rdram_copy, rdram_fill and rdram_equal against per-byte MEM_BU loops for
+// every combination of source and destination alignment and every length up to MAX_CHECK_LENGTH, plus random longer
+// ranges, then times reads and writes of a block against the per-byte loops. The Makefile also builds this with AVX2
+// and without SSE2, so each path through bswap32_words gets checked.
+
+#if defined(__AVX2__)
+#define BSWAP_PATH "AVX2"
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BSWAP_PATH "SSE2"
+#else
+#define BSWAP_PATH "scalar"
+#endif
+
+#define MAX_CHECK_LENGTH 96
+#define LONG_CHECK_COUNT 256
+#define MAX_LONG_LENGTH 4096
+#define BLOCK_SIZE 4096
+#define BLOCK_COUNT 256
+#define ITERATIONS 64
+
+// Sources are taken from the first half of RDRAM and destinations from the second, so ranges never overlap. Both stay a
+// guard distance away from the ends of their half, so the bytes either side of a range can be compared too.
+#define GUARD 8
+#define HALF (BENCH_RDRAM_SIZE / 2)
+
+static uint8_t host_buffers[2][MAX_LONG_LENGTH + 2 * GUARD];
+static int mismatches;
+
+// Counts a mismatch, printing the first few.
+static void report_mismatch(const char* fmt, ...) {
+    va_list args;
+
+    if (mismatches++ < 10) {
+        va_start(args, fmt);
+        vprintf(fmt, args);
+        va_end(args);
+    }
+}
+
+static void ref_read_bytes(uint8_t* rdram, uint8_t* dst, gpr src, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        dst[i] = MEM_BU(0, src + i);
+    }
+}
+
+static void ref_write_bytes(uint8_t* rdram, gpr dst, const uint8_t* src, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        MEM_BU(0, dst + i) = src[i];
+    }
+}
+
+static void ref_copy(uint8_t* rdram, gpr dst, gpr src, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        MEM_BU(0, dst + i) = MEM_BU(0, src + i);
+    }
+}
+
+static void ref_fill(uint8_t* rdram, gpr dst, uint8_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        MEM_BU(0, dst + i) = value;
+    }
+}
+
+static int ref_equal(uint8_t* rdram, gpr a, gpr b, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (MEM_BU(0, a + i) != MEM_BU(0, b + i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static gpr random_address(uint32_t* random_state, uint32_t half, uint32_t alignment) {
+    uint32_t base = (bench_random(random_state) % (HALF - MAX_LONG_LENGTH - 4 * GUARD)) & ~3u;
+    return BENCH_VRAM(half * HALF + 2 * GUARD + base + alignment);
+}
+
+// Compares the bytes from `address - GUARD` to `address + size + GUARD` in both RDRAM buffers.
+static int ranges_match(uint8_t* rdram_bulk, uint8_t* rdram_ref, gpr address, size_t size) {
+    size_t start = (size_t)(address - GUARD - 0xFFFFFFFF80000000);
+    return memcmp(rdram_bulk + start, rdram_ref + start, size + 2 * GUARD) == 0;
+}
+
+static void check_range(uint8_t* rdram_bulk, uint8_t* rdram_ref, uint32_t* random_state, uint32_t dst_alignment,
+                        uint32_t src_alignment, size_t size) {
+    gpr src = random_address(random_state, 0, src_alignment);
+    gpr dst = random_address(random_state, 1, dst_alignment);
+    uint8_t value = (uint8_t)bench_random(random_state);
+    uint8_t* in = host_buffers[0] + GUARD;
+    uint8_t* out_bulk = host_buffers[0] + GUARD;
+    uint8_t* out_ref = host_buffers[1] + GUARD;
+    uint8_t* rdram;
+
+    // Reads, including that nothing outside the host buffer range is written.
+    memset(host_buffers, 0xAA, sizeof(host_buffers));
+    rdram_read_bytes(rdram_bulk, out_bulk, src, size);
+    rdram = rdram_ref;
+    ref_read_bytes(rdram, out_ref, src, size);
+    if (memcmp(host_buffers[0], host_buffers[1], size + 2 * GUARD) != 0) {
+        report_mismatch("  read mismatch: src alignment %u, size %zu\n", src_alignment, size);
+    }
+
+    // Writes from a host buffer at the source's alignment, so unaligned host pointers are covered too.
+    for (size_t i = 0; i < size; i++) {
+        in[src_alignment + i] = (uint8_t)bench_random(random_state);
+    }
+    rdram_write_bytes(rdram_bulk, dst, in + src_alignment, size);
+    ref_write_bytes(rdram, dst, in + src_alignment, size);
+    if (!ranges_match(rdram_bulk, rdram_ref, dst, size)) {
+        report_mismatch("  write mismatch: dst alignment %u, size %zu\n", dst_alignment, size);
+    }
+
+    rdram_copy(rdram_bulk, dst, src, size);
+    ref_copy(rdram, dst, src, size);
+    if (!ranges_match(rdram_bulk, rdram_ref, dst, size)) {
+        report_mismatch("  copy mismatch: dst alignment %u, src alignment %u, size %zu\n", dst_alignment, src_alignment,
+                        size);
+    }
+
+    // The copy left the two ranges equal. Half the time, change one byte of the destination so they aren't.
+    if (size > 0 && (bench_random(random_state) & 1)) {
+        gpr changed = dst + bench_random(random_state) % size;
+        uint8_t flipped = MEM_BU(0, changed) ^ (1 + bench_random(random_state) % 255);
+        MEM_BU(0, changed) = flipped;
+        rdram = rdram_bulk;
+        MEM_BU(0, changed) = flipped;
+        rdram = rdram_ref;
+    }
+    if (rdram_equal(rdram_bulk, dst, src, size) != ref_equal(rdram, dst, src, size)) {
+        report_mismatch("  equal mismatch: dst alignment %u, src alignment %u, size %zu\n", dst_alignment, src_alignment,
+                        size);
+    }
+
+    rdram_fill(rdram_bulk, dst, value, size);
+    ref_fill(rdram, dst, value, size);
+    if (!ranges_match(rdram_bulk, rdram_ref, dst, size)) {
+        report_mismatch("  fill mismatch: dst alignment %u, size %zu\n", dst_alignment, size);
+    }
+}
+
+static int check_equivalence(uint8_t* rdram_bulk, uint8_t* rdram_ref, uint32_t* random_state) {
+    int checks = 0;
+
+    for (uint32_t dst_alignment = 0; dst_alignment < 4; dst_alignment++) {
+        for (uint32_t src_alignment = 0; src_alignment < 4; src_alignment++) {
+            for (size_t size = 0; size <= MAX_CHECK_LENGTH; size++) {
+                check_range(rdram_bulk, rdram_ref, random_state, dst_alignment, src_alignment, size);
+                checks++;
+            }
+            for (int i = 0; i < LONG_CHECK_COUNT; i++) {
+                size_t size = MAX_CHECK_LENGTH + bench_random(random_state) % (MAX_LONG_LENGTH - MAX_CHECK_LENGTH);
+                check_range(rdram_bulk, rdram_ref, random_state, dst_alignment, src_alignment, size);
+                checks++;
+            }
+        }
+    }
+
+    printf("bench_rdram_bulk (%s): %d mismatches in %d ranges\n", BSWAP_PATH, mismatches, checks);
+    return mismatches;
+}
+
+int main(void) {
+    uint8_t* rdram_bulk = bench_alloc_rdram();
+    uint8_t* rdram_ref = bench_alloc_rdram();
+    uint8_t* block = (uint8_t*)malloc(BLOCK_SIZE);
+    gpr addrs[BLOCK_COUNT];
+    uint32_t random_state = 1;
+    double start;
+
+    if (block == NULL) {
+        fprintf(stderr, "Failed to allocate the host block\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < BENCH_RDRAM_SIZE; i++) {
+        rdram_bulk[i] = rdram_ref[i] = (uint8_t)bench_random(&random_state);
+    }
+
+    if (check_equivalence(rdram_bulk, rdram_ref, &random_state) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Word-aligned blocks, as DMA-sized transfers usually are.
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        addrs[i] = BENCH_VRAM(((bench_random(&random_state) % (BENCH_RDRAM_SIZE - BLOCK_SIZE)) & ~3u));
+    }
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < BLOCK_COUNT; j++) {
+            rdram_read_bytes(rdram_bulk, block, addrs[j], BLOCK_SIZE);
+            bench_sink += block[j];
+        }
+    }
+    bench_report("rdram_read_bytes, 4 KB", start, (uint64_t)ITERATIONS * BLOCK_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < BLOCK_COUNT; j++) {
+            ref_read_bytes(rdram_ref, block, addrs[j], BLOCK_SIZE);
+            bench_sink += block[j];
+        }
+    }
+    bench_report("MEM_BU read loop, 4 KB", start, (uint64_t)ITERATIONS * BLOCK_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < BLOCK_COUNT; j++) {
+            rdram_write_bytes(rdram_bulk, addrs[j], block, BLOCK_SIZE);
+        }
+    }
+    bench_report("rdram_write_bytes, 4 KB", start, (uint64_t)ITERATIONS * BLOCK_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < BLOCK_COUNT; j++) {
+            ref_write_bytes(rdram_ref, addrs[j], block, BLOCK_SIZE);
+        }
+    }
+    bench_report("MEM_BU write loop, 4 KB", start, (uint64_t)ITERATIONS * BLOCK_COUNT);
+
+    free(block);
+    free(rdram_bulk);
+    free(rdram_ref);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+#include <string.h>
+
+// Keep the checks for the first copy of the workload even if the build defines NDEBUG.
+#define RECOMP_RUNTIME_CHECKS 1
+
+#include "mod_recomp.h"
+#include "host_bench.h"
+
+// Compares recompiled float code with NAN_CHECK and CHECK_FR enabled against the same code with them removed. There's no
+// recorded workload in the repo, so this transforms vertices by a matrix the way a recompiled guMtxXFMF would, with a
+// register check on every float register access and a NaN check before every conversion.
+
+#define VERTEX_COUNT 4096
+#define ITERATIONS 4096
+
+// Guest layout: the matrix (16 floats) at MTX_OFFSET, input vertices (3 floats each) at IN_OFFSET and output vertices
+// (3 words each) at OUT_OFFSET.
+#define MTX_OFFSET 0x0
+#define IN_OFFSET 0x100
+#define OUT_OFFSET (IN_OFFSET + VERTEX_COUNT * 12)
+
+// One output component: f8 = f0 * m[0][col] + f1 * m[1][col] + f2 * m[2][col] + m[3][col], truncated into the output.
+#define TRANSFORM_COMPONENT(col) \
+    CHECK_FR(ctx, 4); ctx->f4.u32l = MEM_W(0x00 + (col) * 4, ctx->r5); \
+    CHECK_FR(ctx, 5); ctx->f5.u32l = MEM_W(0x10 + (col) * 4, ctx->r5); \
+    CHECK_FR(ctx, 6); ctx->f6.u32l = MEM_W(0x20 + (col) * 4, ctx->r5); \
+    CHECK_FR(ctx, 7); ctx->f7.u32l = MEM_W(0x30 + (col) * 4, ctx->r5); \
+    CHECK_FR(ctx, 8); CHECK_FR(ctx, 0); CHECK_FR(ctx, 4); ctx->f8.fl = MUL_S(ctx->f0.fl, ctx->f4.fl); \
+    CHECK_FR(ctx, 9); CHECK_FR(ctx, 1); CHECK_FR(ctx, 5); ctx->f9.fl = MUL_S(ctx->f1.fl, ctx->f5.fl); \
+    CHECK_FR(ctx, 8); CHECK_FR(ctx, 9); ctx->f8.fl = ctx->f8.fl + ctx->f9.fl; \
+    CHECK_FR(ctx, 9); CHECK_FR(ctx, 2); CHECK_FR(ctx, 6); ctx->f9.fl = MUL_S(ctx->f2.fl, ctx->f6.fl); \
+    CHECK_FR(ctx, 8); CHECK_FR(ctx, 9); ctx->f8.fl = ctx->f8.fl + ctx->f9.fl; \
+    CHECK_FR(ctx, 8); CHECK_FR(ctx, 7); ctx->f8.fl = ctx->f8.fl + ctx->f7.fl; \
+    CHECK_FR(ctx, 10); CHECK_FR(ctx, 8); NAN_CHECK(ctx->f8.fl); ctx->f10.u32l = TRUNC_W_S(ctx->f8.fl); \
+    CHECK_FR(ctx, 10); MEM_W((col) * 4, ctx->r6) = ctx->f10.u32l;
+
+// Defines a transform over every vertex using whatever NAN_CHECK and CHECK_FR are defined as where it's expanded.
+#define DEFINE_TRANSFORM(name) \
+    static void name(uint8_t* rdram, recomp_context* ctx) { \
+        ctx->r4 = BENCH_VRAM(IN_OFFSET); \
+        ctx->r5 = BENCH_VRAM(MTX_OFFSET); \
+        ctx->r6 = BENCH_VRAM(OUT_OFFSET); \
+        for (int i = 0; i < VERTEX_COUNT; i++) { \
+            CHECK_FR(ctx, 0); ctx->f0.u32l = MEM_W(0x0, ctx->r4); \
+            CHECK_FR(ctx, 1); ctx->f1.u32l = MEM_W(0x4, ctx->r4); \
+            CHECK_FR(ctx, 2); ctx->f2.u32l = MEM_W(0x8, ctx->r4); \
+            TRANSFORM_COMPONENT(0) \
+            TRANSFORM_COMPONENT(1) \
+            TRANSFORM_COMPONENT(2) \
+            ctx->r4 = ADD32(ctx->r4, 12); \
+            ctx->r6 = ADD32(ctx->r6, 12); \
+        } \
+    }
+
+DEFINE_TRANSFORM(transform_checked)
+
+#undef NAN_CHECK
+#undef CHECK_FR
+#define NAN_CHECK(val) \
+    ((void)0)
+#define CHECK_FR(ctx, idx) \
+    ((void)0)
+
+DEFINE_TRANSFORM(transform_unchecked)
+
+static void store_float(uint8_t* rdram, uint32_t offset, float val) {
+    memcpy(rdram + offset, &val, sizeof(val));
+}
+
+int main(void) {
+    uint8_t* rdram_checked = bench_alloc_rdram();
+    uint8_t* rdram_unchecked = bench_alloc_rdram();
+    recomp_context ctx_checked;
+    recomp_context ctx_unchecked;
+    uint32_t random_state = 1;
+    double start;
+
+    // Odd float registers are only valid in mips3 float mode, which the workload needs to pass the checks.
+    memset(&ctx_checked, 0, sizeof(ctx_checked));
+    ctx_checked.mips3_float_mode = 1;
+    ctx_unchecked = ctx_checked;
+
+    for (int i = 0; i < 16; i++) {
+        store_float(rdram_checked, MTX_OFFSET + i * 4, (float)(bench_random(&random_state) % 2001) / 1000.0f - 1.0f);
+    }
+    for (int i = 0; i < VERTEX_COUNT * 3; i++) {
+        store_float(rdram_checked, IN_OFFSET + i * 4, (float)(bench_random(&random_state) % 20001) - 10000.0f);
+    }
+    memcpy(rdram_unchecked, rdram_checked, BENCH_RDRAM_SIZE);
+
+    transform_checked(rdram_checked, &ctx_checked);
+    transform_unchecked(rdram_unchecked, &ctx_unchecked);
+    if (memcmp(rdram_checked, rdram_unchecked, BENCH_RDRAM_SIZE) != 0) {
+        printf("bench_runtime_checks: checked and unchecked results differ\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("bench_runtime_checks: float vertex transform (%d vertices)\n", VERTEX_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        transform_checked(rdram_checked, &ctx_checked);
+    }
+    bench_report("NAN_CHECK and CHECK_FR enabled", start, (uint64_t)ITERATIONS * VERTEX_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        transform_unchecked(rdram_unchecked, &ctx_unchecked);
+    }
+    bench_report("NAN_CHECK and CHECK_FR removed", start, (uint64_t)ITERATIONS * VERTEX_COUNT);
+
+    free(rdram_checked);
+    free(rdram_unchecked);
+    return EXIT_SUCCESS;
+}
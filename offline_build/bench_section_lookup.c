@@ -0,0 +1,170 @@
+#include <string.h>
+
+#include "mod_recomp.h"
+#include "host_bench.h"
+
+// Checks recomp_section_lookup_vram and recomp_section_lookup_name against a linear scan over SECTION_COUNT synthetic
+// sections, one per overlay in overlays.us.rev1.txt, then times both. Sections get random sizes and gaps between them
+// and are shuffled before the index is built, so it has to do its own sorting. Addresses are checked at both ends of
+// every section and the gaps around them, as well as at random.
+
+#define SECTION_COUNT 617
+#define RANDOM_CHECK_COUNT (1 << 18)
+#define QUERY_COUNT 4096
+#define ITERATIONS 1024
+
+static recomp_section_range ranges[SECTION_COUNT];
+static const recomp_section_range* by_name[SECTION_COUNT];
+static char names[SECTION_COUNT][16];
+static uint32_t vram_queries[QUERY_COUNT];
+static const char* name_queries[QUERY_COUNT];
+static int mismatches;
+
+static const recomp_section_range* linear_lookup_vram(uint32_t vram) {
+    for (size_t i = 0; i < SECTION_COUNT; i++) {
+        if (ranges[i].vram_start <= vram && vram < ranges[i].vram_end) {
+            return &ranges[i];
+        }
+    }
+    return NULL;
+}
+
+static const recomp_section_range* linear_lookup_name(const char* name) {
+    for (size_t i = 0; i < SECTION_COUNT; i++) {
+        if (strcmp(ranges[i].name, name) == 0) {
+            return &ranges[i];
+        }
+    }
+    return NULL;
+}
+
+static void check_vram(const recomp_section_lookup* lookup, uint32_t vram) {
+    const recomp_section_range* indexed = recomp_section_lookup_vram(lookup, vram);
+    const recomp_section_range* linear = linear_lookup_vram(vram);
+
+    if (indexed != linear && mismatches++ < 10) {
+        printf("  vram mismatch at 0x%08X: index %s, linear scan %s\n", vram, indexed != NULL ? indexed->name : "none",
+               linear != NULL ? linear->name : "none");
+    }
+}
+
+static void check_name(const recomp_section_lookup* lookup, const char* name) {
+    const recomp_section_range* indexed = recomp_section_lookup_name(lookup, name);
+    const recomp_section_range* linear = linear_lookup_name(name);
+
+    if (indexed != linear && mismatches++ < 10) {
+        printf("  name mismatch for %s\n", name);
+    }
+}
+
+// Lays the sections out one after another from 0x80800000 with random sizes and gaps, then shuffles them.
+static void make_sections(uint32_t* random_state) {
+    uint32_t vram = 0x80800000;
+
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        snprintf(names[i], sizeof(names[i]), "ovl_%03d", i);
+        vram += (bench_random(random_state) % 4) * 0x10 * (bench_random(random_state) % 64);
+        ranges[i].name = names[i];
+        ranges[i].vram_start = vram;
+        vram += 0x10 + (bench_random(random_state) % 0x2000) * 0x10;
+        ranges[i].vram_end = vram;
+        ranges[i].section_index = i;
+    }
+
+    for (int i = SECTION_COUNT - 1; i > 0; i--) {
+        int j = bench_random(random_state) % (i + 1);
+        recomp_section_range tmp = ranges[i];
+        ranges[i] = ranges[j];
+        ranges[j] = tmp;
+    }
+}
+
+static int check_equivalence(const recomp_section_lookup* lookup, uint32_t* random_state) {
+    uint32_t lowest = 0xFFFFFFFF;
+    uint32_t highest = 0;
+
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        const recomp_section_range* range = &ranges[i];
+
+        check_vram(lookup, range->vram_start - 1);
+        check_vram(lookup, range->vram_start);
+        check_vram(lookup, range->vram_end - 1);
+        check_vram(lookup, range->vram_end);
+        check_name(lookup, range->name);
+        lowest = range->vram_start < lowest ? range->vram_start : lowest;
+        highest = range->vram_end > highest ? range->vram_end : highest;
+    }
+
+    check_vram(lookup, 0);
+    check_vram(lookup, 0xFFFFFFFF);
+    for (int i = 0; i < RANDOM_CHECK_COUNT; i++) {
+        check_vram(lookup, lowest - 0x1000 + bench_random(random_state) % (highest - lowest + 0x2000));
+    }
+
+    check_name(lookup, "");
+    check_name(lookup, "ovl_");
+    check_name(lookup, "ovl_617");
+    check_name(lookup, "ovl_0000");
+    check_name(lookup, "zzz");
+
+    return mismatches;
+}
+
+int main(void) {
+    recomp_section_lookup lookup;
+    uint32_t random_state = 1;
+    uint64_t sum;
+    double start;
+
+    make_sections(&random_state);
+    recomp_section_lookup_build(&lookup, ranges, by_name, SECTION_COUNT);
+
+    int failures = check_equivalence(&lookup, &random_state);
+    printf("bench_section_lookup: %d mismatches against a linear scan of %d sections\n", failures, SECTION_COUNT);
+    if (failures != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Addresses inside random sections, and names of random sections.
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        const recomp_section_range* range = &ranges[bench_random(&random_state) % SECTION_COUNT];
+        vram_queries[i] = range->vram_start + bench_random(&random_state) % (range->vram_end - range->vram_start);
+        name_queries[i] = range->name;
+    }
+
+    sum = 0;
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < QUERY_COUNT; j++) {
+            sum += recomp_section_lookup_vram(&lookup, vram_queries[j])->section_index;
+        }
+    }
+    bench_report("recomp_section_lookup_vram", start, (uint64_t)ITERATIONS * QUERY_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS / 16; i++) {
+        for (int j = 0; j < QUERY_COUNT; j++) {
+            sum += linear_lookup_vram(vram_queries[j])->section_index;
+        }
+    }
+    bench_report("linear scan by vram", start, (uint64_t)ITERATIONS / 16 * QUERY_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (int j = 0; j < QUERY_COUNT; j++) {
+            sum += recomp_section_lookup_name(&lookup, name_queries[j])->section_index;
+        }
+    }
+    bench_report("recomp_section_lookup_name", start, (uint64_t)ITERATIONS * QUERY_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS / 16; i++) {
+        for (int j = 0; j < QUERY_COUNT; j++) {
+            sum += linear_lookup_name(name_queries[j])->section_index;
+        }
+    }
+    bench_report("linear scan by name", start, (uint64_t)ITERATIONS / 16 * QUERY_COUNT);
+
+    bench_sink += sum;
+    return EXIT_SUCCESS;
+}
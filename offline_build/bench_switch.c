@@ -0,0 +1,103 @@
+#include "mod_recomp.h"
+#include "host_bench.h"
+
+// Compares jump table dispatch with the default case routed through the cold recomp_switch_error wrapper against the
+// same switch calling the runtime's switch_error pointer directly, as recompiled code did before. Indices are random and
+// always in range, so only the layout of the switch differs, never the path taken.
+
+#define INDEX_COUNT 4096
+#define ITERATIONS 16384
+
+// The runtime normally provides this. In range indices never reach it.
+static void bench_switch_error(const char* func, uint32_t vram, uint32_t jtbl) {
+    fprintf(stderr, "%s: switch error at 0x%08X (jump table 0x%08X)\n", func, vram, jtbl);
+    exit(EXIT_FAILURE);
+}
+
+void (*switch_error)(const char* func, uint32_t vram, uint32_t jtbl) = bench_switch_error;
+
+static uint32_t indices[INDEX_COUNT];
+
+// Each case does different work so the compiler keeps a real jump table instead of turning it into a value lookup.
+#define CASE(n, op) \
+    case n: ctx->r2 = ADD32(op, n); break;
+
+// Defines a dispatch loop whose default case calls ERROR, either the switch_error macro or the raw (switch_error).
+#define DEFINE_DISPATCH(name, ERROR) \
+    static void name(recomp_context* ctx) { \
+        for (int i = 0; i < INDEX_COUNT; i++) { \
+            ctx->r14 = indices[i]; \
+            switch (ctx->r14) { \
+                CASE(0, ctx->r2 + ctx->r4) \
+                CASE(1, ctx->r2 - ctx->r5) \
+                CASE(2, ctx->r2 ^ ctx->r6) \
+                CASE(3, ctx->r2 << 3) \
+                CASE(4, ctx->r2 >> 5) \
+                CASE(5, ctx->r2 | ctx->r7) \
+                CASE(6, ctx->r2 & ctx->r4) \
+                CASE(7, ctx->r2 * 3) \
+                CASE(8, ctx->r5 - ctx->r2) \
+                CASE(9, ctx->r2 + (ctx->r6 << 1)) \
+                CASE(10, ctx->r2 ^ (ctx->r7 >> 2)) \
+                CASE(11, ctx->r2 + ctx->r4 + ctx->r5) \
+                CASE(12, ~ctx->r2) \
+                CASE(13, ctx->r2 - (ctx->r4 << 2)) \
+                CASE(14, ctx->r2 * 5 + ctx->r6) \
+                CASE(15, ctx->r2 ^ 0x5A5A) \
+                CASE(16, ctx->r2 + 0x1234) \
+                CASE(17, (ctx->r2 >> 1) + ctx->r7) \
+                CASE(18, ctx->r2 | 0x80) \
+                CASE(19, ctx->r2 & 0xFFFF) \
+                CASE(20, ctx->r2 * 7) \
+                CASE(21, ctx->r4 ^ ctx->r2 ^ ctx->r5) \
+                CASE(22, ctx->r2 + (ctx->r2 >> 4)) \
+                CASE(23, ctx->r2 - 0x77) \
+                default: \
+                    ERROR(__func__, 0x80012340, 0x80100000); \
+            } \
+        } \
+    }
+
+DEFINE_DISPATCH(dispatch_cold, switch_error)
+DEFINE_DISPATCH(dispatch_direct, (switch_error))
+
+int main(void) {
+    recomp_context ctx_cold = { 0 };
+    recomp_context ctx_direct;
+    uint32_t random_state = 1;
+    double start;
+
+    ctx_cold.r4 = 0x1111;
+    ctx_cold.r5 = 0x2222;
+    ctx_cold.r6 = 0x3333;
+    ctx_cold.r7 = 0x4444;
+    ctx_direct = ctx_cold;
+
+    for (int i = 0; i < INDEX_COUNT; i++) {
+        indices[i] = bench_random(&random_state) % 24;
+    }
+
+    dispatch_cold(&ctx_cold);
+    dispatch_direct(&ctx_direct);
+    if (ctx_cold.r2 != ctx_direct.r2) {
+        printf("bench_switch: cold and direct dispatch results differ\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("bench_switch: jump table dispatch (%d random in range indices)\n", INDEX_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        dispatch_cold(&ctx_cold);
+    }
+    bench_report("default through recomp_switch_error", start, (uint64_t)ITERATIONS * INDEX_COUNT);
+
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        dispatch_direct(&ctx_direct);
+    }
+    bench_report("default calls switch_error directly", start, (uint64_t)ITERATIONS * INDEX_COUNT);
+
+    bench_sink = ctx_cold.r2 + ctx_direct.r2;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,48 @@
+#ifndef __HOST_BENCH_H__
+#define __HOST_BENCH_H__
+
+// Shared helpers for the host benchmarks and tests of mod_recomp.h in this directory. Build and run them all with
+// `make offline-bench`.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Size of the RDRAM buffer the benchmarks work in. Guest address 0x80000000 is the start of it.
+#define BENCH_RDRAM_SIZE (8 * 1024 * 1024)
+
+// Guest address of an offset into the RDRAM buffer, sign extended the way recompiled code holds addresses.
+#define BENCH_VRAM(offset) \
+    ((gpr)(int32_t)(0x80000000u + (uint32_t)(offset)))
+
+// Stores results that would otherwise be optimized out.
+static volatile uint64_t bench_sink;
+
+static inline double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static inline void bench_report(const char* name, double start_ns, uint64_t ops) {
+    printf("  %-44s %8.3f ns/op\n", name, (bench_now_ns() - start_ns) / ops);
+}
+
+static inline uint8_t* bench_alloc_rdram(void) {
+    uint8_t* rdram = (uint8_t*)calloc(BENCH_RDRAM_SIZE, 1);
+    if (rdram == NULL) {
+        fprintf(stderr, "Failed to allocate RDRAM\n");
+        exit(EXIT_FAILURE);
+    }
+    return rdram;
+}
+
+static inline uint32_t bench_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+#endif
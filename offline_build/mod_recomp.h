@@ -5,6 +5,14 @@
 #include <stdint.h>
 #include <math.h>
 #include <assert.h>
+#include <string.h>
+#include <stddef.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
 
 #if defined(_WIN32)
 #define RECOMP_EXPORT __declspec(dllexport)
@@ -13,7 +21,11 @@
 #endif
 
 // Compiler definition to disable inter-procedural optimization, allowing multiple functions to be in a single file without breaking interposition.
-#if defined(_MSC_VER) && !defined(__clang__)
+// Define RECOMP_ALLOW_IPO to drop this when the mod's functions never need to be interposed (i.e. no other mod hooks them),
+// so the compiler can inline them into each other.
+#if defined(RECOMP_ALLOW_IPO)
+    #define RECOMP_FUNC RECOMP_EXPORT
+#elif defined(_MSC_VER) && !defined(__clang__)
     // MSVC's __declspec(noinline) seems to disable inter-procedural optimization entirely, so it's all that's needed.
     #define RECOMP_FUNC RECOMP_EXPORT __declspec(noinline)
 #elif defined(__clang__)
@@ -55,17 +67,26 @@ typedef uint64_t gpr;
 #define MEM_BU(offset, reg) \
     (*(uint8_t*)(rdram + ((((reg) + (offset)) ^ 3) - 0xFFFFFFFF80000000)))
 
+// A doubleword is stored as its high word followed by its low word, each in native byte order, so the whole doubleword
+// can be moved with a single 64-bit access and a rotate. This holds for any word-aligned address, which covers every
+// valid LD/SD as they require 8-byte alignment.
+static inline uint64_t rotate_doubleword(uint64_t val) {
+    return (val >> 32) | (val << 32);
+}
+
+static inline void store_doubleword(uint8_t* rdram, gpr reg, gpr offset, uint64_t val) {
+    val = rotate_doubleword(val);
+    memcpy(rdram + ((reg + offset) - 0xFFFFFFFF80000000), &val, sizeof(val));
+}
+
 #define SD(val, offset, reg) { \
-    *(uint32_t*)(rdram + ((((reg) + (offset) + 4)) - 0xFFFFFFFF80000000)) = (uint32_t)((gpr)(val) >> 0); \
-    *(uint32_t*)(rdram + ((((reg) + (offset) + 0)) - 0xFFFFFFFF80000000)) = (uint32_t)((gpr)(val) >> 32); \
+    store_doubleword(rdram, reg, offset, (gpr)(val)); \
 }
 
 static inline uint64_t load_doubleword(uint8_t* rdram, gpr reg, gpr offset) {
-    uint64_t ret = 0;
-    uint64_t lo = (uint64_t)(uint32_t)MEM_W(reg, offset + 4);
-    uint64_t hi = (uint64_t)(uint32_t)MEM_W(reg, offset + 0);
-    ret = (lo << 0) | (hi << 32);
-    return ret;
+    uint64_t ret;
+    memcpy(&ret, rdram + ((reg + offset) - 0xFFFFFFFF80000000), sizeof(ret));
+    return rotate_doubleword(ret);
 }
 
 #define LD(offset, reg) \
@@ -135,6 +156,196 @@ static inline void do_swr(uint8_t* rdram, gpr offset, gpr reg, gpr val) {
     MEM_W(0, word_address) = masked_initial_value | shifted_input_value;
 }
 
+// Fused versions of the LWL/LWR and SWL/SWR pairs used to access an unaligned word, where the LWL/SWL targets the word's
+// first byte and the LWR/SWR targets its last byte. When the word is unaligned, both words it spans are moved as one
+// doubleword, so the result is a single shift without any masking of a previous register value. An aligned word is a
+// plain word access, as the doubleword would also cover the following word, which the pair never touches and which
+// something else may be writing to.
+static inline gpr do_lwl_lwr(uint8_t* rdram, gpr offset, gpr reg) {
+    gpr address = (offset + reg);
+    gpr misalignment = address & 0x3;
+
+    if (misalignment == 0) {
+        return (gpr)MEM_W(0, address);
+    }
+
+    uint64_t words = load_doubleword(rdram, address & ~0x3, 0);
+
+    // Cast to int32_t to sign extend first
+    return (gpr)(int32_t)(uint32_t)(words >> (32 - misalignment * 8));
+}
+
+static inline void do_swl_swr(uint8_t* rdram, gpr offset, gpr reg, gpr val) {
+    gpr address = (offset + reg);
+    gpr word_address = address & ~0x3;
+
+    if ((address & 0x3) == 0) {
+        MEM_W(0, address) = (int32_t)val;
+        return;
+    }
+
+    unsigned int shift = 32 - (unsigned int)(address & 0x3) * 8;
+    uint64_t words = load_doubleword(rdram, word_address, 0);
+
+    words = (words & ~(0xFFFFFFFFull << shift)) | ((uint64_t)(uint32_t)val << shift);
+    store_doubleword(rdram, word_address, 0, words);
+}
+
+// Bulk helpers for ranges of RDRAM.
+// RDRAM is stored as native-endian 32-bit words, so ranges with the same alignment within a word can be copied or compared
+// directly with host memory functions, while moving data to or from a big-endian host buffer needs every word byteswapped.
+// None of these handle overlapping ranges.
+
+static inline uint8_t* rdram_ptr(uint8_t* rdram, gpr address) {
+    return rdram + (address - 0xFFFFFFFF80000000);
+}
+
+// Byteswaps `count` 32-bit words from `src` into `dst`. Neither pointer needs to be aligned.
+static inline void bswap32_words(void* dst, const void* src, size_t count) {
+    uint8_t* out = (uint8_t*)dst;
+    const uint8_t* in = (const uint8_t*)src;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i swap_mask = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(in + i * 4));
+        _mm256_storeu_si256((__m256i*)(out + i * 4), _mm256_shuffle_epi8(v, swap_mask));
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i * 4));
+        // Swap the bytes in each halfword, then the halfwords in each word.
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128((__m128i*)(out + i * 4), v);
+    }
+#endif
+    for (; i < count; i++) {
+        uint32_t word;
+        memcpy(&word, in + i * 4, sizeof(word));
+        word = (word >> 24) | ((word >> 8) & 0xFF00) | ((word << 8) & 0xFF0000) | (word << 24);
+        memcpy(out + i * 4, &word, sizeof(word));
+    }
+}
+
+// Copies `size` bytes from RDRAM address `src` into the host buffer `dst`, in the N64's big-endian byte order.
+static inline void rdram_read_bytes(uint8_t* rdram, void* dst, gpr src, size_t size) {
+    uint8_t* out = (uint8_t*)dst;
+
+    for (; size > 0 && (src & 3) != 0; size--) {
+        *out++ = MEM_BU(0, src++);
+    }
+
+    size_t words = size / 4;
+    bswap32_words(out, rdram_ptr(rdram, src), words);
+    out += words * 4;
+    src += words * 4;
+    size -= words * 4;
+
+    for (; size > 0; size--) {
+        *out++ = MEM_BU(0, src++);
+    }
+}
+
+// Copies `size` bytes in big-endian byte order from the host buffer `src` to RDRAM address `dst`.
+static inline void rdram_write_bytes(uint8_t* rdram, gpr dst, const void* src, size_t size) {
+    const uint8_t* in = (const uint8_t*)src;
+
+    for (; size > 0 && (dst & 3) != 0; size--) {
+        MEM_BU(0, dst++) = *in++;
+    }
+
+    size_t words = size / 4;
+    bswap32_words(rdram_ptr(rdram, dst), in, words);
+    in += words * 4;
+    dst += words * 4;
+    size -= words * 4;
+
+    for (; size > 0; size--) {
+        MEM_BU(0, dst++) = *in++;
+    }
+}
+
+// Copies `size` bytes from RDRAM address `src` to RDRAM address `dst`.
+static inline void rdram_copy(uint8_t* rdram, gpr dst, gpr src, size_t size) {
+    // Ranges with different alignments within a word don't share a layout, so they have to be copied a byte at a time.
+    if (((dst ^ src) & 3) != 0) {
+        for (; size > 0; size--) {
+            MEM_BU(0, dst++) = MEM_BU(0, src++);
+        }
+        return;
+    }
+
+    for (; size > 0 && (dst & 3) != 0; size--) {
+        MEM_BU(0, dst++) = MEM_BU(0, src++);
+    }
+
+    size_t words = size / 4;
+    memcpy(rdram_ptr(rdram, dst), rdram_ptr(rdram, src), words * 4);
+    dst += words * 4;
+    src += words * 4;
+    size -= words * 4;
+
+    for (; size > 0; size--) {
+        MEM_BU(0, dst++) = MEM_BU(0, src++);
+    }
+}
+
+// Sets `size` bytes starting at RDRAM address `dst` to `value`.
+static inline void rdram_fill(uint8_t* rdram, gpr dst, uint8_t value, size_t size) {
+    for (; size > 0 && (dst & 3) != 0; size--) {
+        MEM_BU(0, dst++) = value;
+    }
+
+    // Every byte of a whole word gets the same value, so the word swizzle doesn't matter.
+    size_t words = size / 4;
+    memset(rdram_ptr(rdram, dst), value, words * 4);
+    dst += words * 4;
+    size -= words * 4;
+
+    for (; size > 0; size--) {
+        MEM_BU(0, dst++) = value;
+    }
+}
+
+// Returns 1 if the `size` bytes at RDRAM addresses `a` and `b` are equal, otherwise returns 0.
+static inline int rdram_equal(uint8_t* rdram, gpr a, gpr b, size_t size) {
+    if (((a ^ b) & 3) != 0) {
+        for (; size > 0; size--) {
+            if (MEM_BU(0, a++) != MEM_BU(0, b++)) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+
+    for (; size > 0 && (a & 3) != 0; size--) {
+        if (MEM_BU(0, a++) != MEM_BU(0, b++)) {
+            return 0;
+        }
+    }
+
+    size_t words = size / 4;
+    if (memcmp(rdram_ptr(rdram, a), rdram_ptr(rdram, b), words * 4) != 0) {
+        return 0;
+    }
+    a += words * 4;
+    b += words * 4;
+    size -= words * 4;
+
+    for (; size > 0; size--) {
+        if (MEM_BU(0, a++) != MEM_BU(0, b++)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 #define S32(val) \
     ((int32_t)(val))
     
@@ -185,10 +396,25 @@ static inline void do_swr(uint8_t* rdram, gpr offset, gpr reg, gpr val) {
 
 #define DEFAULT_ROUNDING_MODE 0
 
+// Rounds to the nearest integer with halfway cases away from zero, giving the same results as lroundf/lround without a
+// call into libm. The remainder is always exact: it's either the value itself, zero once the value is too large to have
+// a fractional part, or the difference between two values within a factor of two of each other.
+static inline int32_t do_cvt_w_s_nearest(float val) {
+    int32_t truncated = (int32_t)val;
+    float remainder = val - (float)truncated;
+    return truncated + (remainder >= 0.5f) - (remainder <= -0.5f);
+}
+
+static inline int32_t do_cvt_w_d_nearest(double val) {
+    int32_t truncated = (int32_t)val;
+    double remainder = val - (double)truncated;
+    return truncated + (remainder >= 0.5) - (remainder <= -0.5);
+}
+
 static inline int32_t do_cvt_w_s(float val, unsigned int rounding_mode) {
     switch (rounding_mode) {
         case 0: // round to nearest value
-            return (int32_t)lroundf(val);
+            return do_cvt_w_s_nearest(val);
         case 1: // round to zero (truncate)
             return (int32_t)val;
         case 2: // round to positive infinity (ceil)
@@ -200,13 +426,15 @@ static inline int32_t do_cvt_w_s(float val, unsigned int rounding_mode) {
     return 0;
 }
 
+// Almost all code runs in the default rounding mode and never writes to the FPU status register, in which case
+// rounding_mode is a constant and the compiler removes the check along with the general path.
 #define CVT_W_S(val) \
-    do_cvt_w_s(val, rounding_mode)
+    ((rounding_mode) == DEFAULT_ROUNDING_MODE ? do_cvt_w_s_nearest(val) : do_cvt_w_s(val, rounding_mode))
 
 static inline int32_t do_cvt_w_d(double val, unsigned int rounding_mode) {
     switch (rounding_mode) {
         case 0: // round to nearest value
-            return (int32_t)lround(val);
+            return do_cvt_w_d_nearest(val);
         case 1: // round to zero (truncate)
             return (int32_t)val;
         case 2: // round to positive infinity (ceil)
@@ -219,12 +447,35 @@ static inline int32_t do_cvt_w_d(double val, unsigned int rounding_mode) {
 }
 
 #define CVT_W_D(val) \
-    do_cvt_w_d(val, rounding_mode)
+    ((rounding_mode) == DEFAULT_ROUNDING_MODE ? do_cvt_w_d_nearest(val) : do_cvt_w_d(val, rounding_mode))
+
+// NAN_CHECK and CHECK_FR validate every conversion and odd float register access. Like the asserts they used to be,
+// they're enabled unless the build defines NDEBUG. RECOMP_RUNTIME_CHECKS can be set to 1 or 0 to keep or remove them
+// regardless, e.g. to keep them in an optimized build. bench_runtime_checks.c measures what they cost.
+#ifndef RECOMP_RUNTIME_CHECKS
+#ifdef NDEBUG
+#define RECOMP_RUNTIME_CHECKS 0
+#else
+#define RECOMP_RUNTIME_CHECKS 1
+#endif
+#endif
 
-#define NAN_CHECK(val) \
-    assert(val == val)
+// assert is compiled out by NDEBUG, so checks that were explicitly kept in such a build abort on their own.
+#if RECOMP_RUNTIME_CHECKS && defined(NDEBUG)
+#define RECOMP_CHECK(cond) \
+    ((cond) ? (void)0 : abort())
+#else
+#define RECOMP_CHECK(cond) \
+    assert(cond)
+#endif
 
-//#define NAN_CHECK(val)
+#if RECOMP_RUNTIME_CHECKS
+#define NAN_CHECK(val) \
+    RECOMP_CHECK(val == val)
+#else
+#define NAN_CHECK(val) \
+    ((void)0)
+#endif
 
 typedef union {
     double d;
@@ -254,9 +505,27 @@ typedef struct {
     uint8_t mips3_float_mode;
 } recomp_context;
 
+// The context layout is shared with the runtime, so it can't be reordered without rebuilding both sides. It already
+// keeps the integer registers ahead of the FPU state, with the argument registers (a0-a3, r4-r7) in the first 64 bytes
+// and the stack pointer and return address (r29, r31) at bytes 232-255. Every function uses sp and ra, so even one that
+// only reads its arguments touches at least two cache lines, and more if the runtime doesn't allocate the context
+// 64-byte aligned. Code that doesn't use the FPU never touches the FPU state. These checks keep that ordering.
+#ifdef __cplusplus
+static_assert(offsetof(recomp_context, r7) + sizeof(gpr) <= 64, "a0-a3 must stay in the first cache line of recomp_context");
+static_assert(offsetof(recomp_context, r31) + sizeof(gpr) <= offsetof(recomp_context, f0), "GPRs must stay ahead of FPU state");
+#else
+_Static_assert(offsetof(recomp_context, r7) + sizeof(gpr) <= 64, "a0-a3 must stay in the first cache line of recomp_context");
+_Static_assert(offsetof(recomp_context, r31) + sizeof(gpr) <= offsetof(recomp_context, f0), "GPRs must stay ahead of FPU state");
+#endif
+
 // Checks if the target is an even float register or that mips3 float mode is enabled
+#if RECOMP_RUNTIME_CHECKS
+#define CHECK_FR(ctx, idx) \
+    RECOMP_CHECK(((idx) & 1) == 0 || (ctx)->mips3_float_mode)
+#else
 #define CHECK_FR(ctx, idx) \
-    assert(((idx) & 1) == 0 || (ctx)->mips3_float_mode)
+    ((void)0)
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -270,9 +539,106 @@ extern RECOMP_EXPORT gpr (*cop0_status_read)(recomp_context* ctx);
 extern RECOMP_EXPORT void (*switch_error)(const char* func, uint32_t vram, uint32_t jtbl);
 extern RECOMP_EXPORT void (*do_break)(uint32_t vram);
 
+// Jump tables are recompiled into a switch over the table index, with switch_error as the default case, so the compiler
+// already emits a bounds-checked host jump table for them. Route the default case through a cold, out of line function so
+// the error call is moved away from the dispatch and isn't treated as a likely target when laying out the switch.
+// The function-like macro only expands on calls, so (switch_error) still names the runtime's pointer.
+// It is marked unused so files that include this header without any jump tables build without warnings.
+#if defined(__GNUC__) || defined(__clang__)
+static __attribute__((cold,noinline,unused)) void recomp_switch_error(const char* func, uint32_t vram, uint32_t jtbl) {
+    (switch_error)(func, vram, jtbl);
+}
+
+#define switch_error(func, vram, jtbl) \
+    recomp_switch_error(func, vram, jtbl)
+#endif
+
+// Define RECOMP_LOOKUP_CACHE to give every LOOKUP_FUNC call site its own single-entry cache of the last function it
+// looked up, so repeated indirect calls to the same target (e.g. an actor's draw function every frame) skip get_function.
+// This needs the runtime to point lookup_cache_generation at a counter that it increments whenever code is loaded or
+// unloaded (such as an overlay), which invalidates every cached entry. No runtime does that yet. While it's NULL, lookups
+// go straight to get_function, so defining RECOMP_LOOKUP_CACHE only adds a TLS access and a NULL check to every call site
+// without any hits. Leave it off until the runtime supports it.
+// Exactly one file must also define RECOMP_LOOKUP_CACHE_IMPL to provide the variables below.
+// Define RECOMP_LOOKUP_CACHE_STATS as well to count hits and misses in lookup_cache_hits and lookup_cache_misses. These
+// are totals across all threads that aren't updated atomically, so they're approximate when several threads make calls,
+// and every thread writes to the same cache line. Leave them off outside of profiling.
+#if defined(RECOMP_LOOKUP_CACHE) && (defined(__GNUC__) || defined(__clang__))
+
+extern RECOMP_EXPORT uint32_t* lookup_cache_generation;
+
+#ifdef RECOMP_LOOKUP_CACHE_IMPL
+RECOMP_EXPORT uint32_t* lookup_cache_generation = NULL;
+#endif
+
+#ifdef RECOMP_LOOKUP_CACHE_STATS
+extern RECOMP_EXPORT uint64_t lookup_cache_hits;
+extern RECOMP_EXPORT uint64_t lookup_cache_misses;
+
+#ifdef RECOMP_LOOKUP_CACHE_IMPL
+RECOMP_EXPORT uint64_t lookup_cache_hits = 0;
+RECOMP_EXPORT uint64_t lookup_cache_misses = 0;
+#endif
+
+#define LOOKUP_CACHE_COUNT(counter) \
+    ((counter)++)
+#else
+#define LOOKUP_CACHE_COUNT(counter) \
+    ((void)0)
+#endif
+
+// The mod is loaded as a shared library, where thread local variables default to a dynamic TLS model that can need a
+// __tls_get_addr call for every access, which would cost about as much as the lookup being skipped. The initial-exec
+// model makes each access a fixed offset from the thread pointer instead. The catch is that the entries (16 bytes per
+// call site) come out of the small static TLS reserve the C runtime keeps for libraries loaded at runtime, so a mod with
+// enough LOOKUP_FUNC sites to exhaust it will fail to load. Define RECOMP_LOOKUP_CACHE_TLS_MODEL as "global-dynamic" in
+// that case. Windows has no equivalent attribute, and its TLS accesses don't need a call anyway.
+#ifndef RECOMP_LOOKUP_CACHE_TLS_MODEL
+#define RECOMP_LOOKUP_CACHE_TLS_MODEL "initial-exec"
+#endif
+
+#if defined(_WIN32)
+#define LOOKUP_CACHE_THREAD_LOCAL __thread
+#else
+#define LOOKUP_CACHE_THREAD_LOCAL __thread __attribute__((tls_model(RECOMP_LOOKUP_CACHE_TLS_MODEL)))
+#endif
+
+typedef struct {
+    recomp_func_t* func;
+    int32_t vram;
+    uint32_t generation;
+} lookup_cache_entry;
+
+static inline recomp_func_t* lookup_func_cached(lookup_cache_entry* entry, int32_t vram) {
+    uint32_t* generation = lookup_cache_generation;
+
+    if (generation == NULL) {
+        return get_function(vram);
+    }
+
+    if (entry->func != NULL && entry->vram == vram && entry->generation == *generation) {
+        LOOKUP_CACHE_COUNT(lookup_cache_hits);
+        return entry->func;
+    }
+
+    LOOKUP_CACHE_COUNT(lookup_cache_misses);
+    entry->generation = *generation;
+    entry->vram = vram;
+    entry->func = get_function(vram);
+    return entry->func;
+}
+
+// The entry is thread local so that threads calling through the same site never see each other's partially written entry.
+#define LOOKUP_FUNC(val) \
+    ({ static LOOKUP_CACHE_THREAD_LOCAL lookup_cache_entry lookup_entry; lookup_func_cached(&lookup_entry, (int32_t)(val)); })
+
+#else
+
 #define LOOKUP_FUNC(val) \
     get_function((int32_t)(val))
 
+#endif
+
 extern RECOMP_EXPORT int32_t* reference_section_addresses;
 extern RECOMP_EXPORT int32_t section_addresses[];
 
@@ -294,6 +660,82 @@ extern RECOMP_EXPORT int32_t section_addresses[];
 #define REF_RELOC_LO16(section_index, offset) \
     LO16(reference_section_addresses[section_index] + (offset))
 
+// Lookup index over relocatable sections (e.g. the overlays in overlays.us.rev1.txt), for answering "which section owns
+// this address" and "where is this overlay" without walking the section list. Build it once after the section ranges
+// are known, and rebuild it if they change. The index only holds pointers into the caller's arrays. Sections mustn't
+// overlap, which holds for the game's overlays as each one has its own vram range.
+typedef struct {
+    const char* name;
+    uint32_t vram_start;
+    uint32_t vram_end;
+    uint32_t section_index;
+} recomp_section_range;
+
+typedef struct {
+    // Sorted by vram_start.
+    recomp_section_range* by_vram;
+    // Sorted by name.
+    const recomp_section_range** by_name;
+    size_t count;
+} recomp_section_lookup;
+
+static inline int recomp_section_compare_vram(const void* a, const void* b) {
+    uint32_t vram_a = ((const recomp_section_range*)a)->vram_start;
+    uint32_t vram_b = ((const recomp_section_range*)b)->vram_start;
+    return (vram_a > vram_b) - (vram_a < vram_b);
+}
+
+static inline int recomp_section_compare_name(const void* a, const void* b) {
+    return strcmp((*(const recomp_section_range* const*)a)->name, (*(const recomp_section_range* const*)b)->name);
+}
+
+// Sorts `ranges` in place and fills `by_name`, which must have room for `count` pointers.
+static inline void recomp_section_lookup_build(recomp_section_lookup* lookup, recomp_section_range* ranges,
+                                               const recomp_section_range** by_name, size_t count) {
+    qsort(ranges, count, sizeof(ranges[0]), recomp_section_compare_vram);
+    for (size_t i = 0; i < count; i++) {
+        by_name[i] = &ranges[i];
+    }
+    qsort((void*)by_name, count, sizeof(by_name[0]), recomp_section_compare_name);
+
+    lookup->by_vram = ranges;
+    lookup->by_name = by_name;
+    lookup->count = count;
+}
+
+// Returns the section containing `vram`, or NULL if there isn't one. Only the last section starting at or before `vram`
+// is checked, so with overlapping sections this can miss an earlier one that also contains it.
+static inline const recomp_section_range* recomp_section_lookup_vram(const recomp_section_lookup* lookup, uint32_t vram) {
+    size_t lo = 0;
+    size_t hi = lookup->count;
+
+    // Find the first section that starts after vram, then check the one before it.
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (lookup->by_vram[mid].vram_start <= vram) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0 || vram >= lookup->by_vram[lo - 1].vram_end) {
+        return NULL;
+    }
+    return &lookup->by_vram[lo - 1];
+}
+
+// Returns the section with the given name, or NULL if there isn't one.
+static inline const recomp_section_range* recomp_section_lookup_name(const recomp_section_lookup* lookup, const char* name) {
+    recomp_section_range key;
+    const recomp_section_range* key_ptr = &key;
+    key.name = name;
+
+    const recomp_section_range** found = (const recomp_section_range**)bsearch(
+        &key_ptr, lookup->by_name, lookup->count, sizeof(lookup->by_name[0]), recomp_section_compare_name);
+    return found != NULL ? *found : NULL;
+}
+
 void recomp_syscall_handler(uint8_t* rdram, recomp_context* ctx, int32_t instruction_vram);
 
 void pause_self(uint8_t *rdram);
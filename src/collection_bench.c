@@ -0,0 +1,204 @@
+#include "global.h"
+#include "modding.h"
+#include "recomputils.h"
+#include "recompconfig.h"
+#include "recompdata.h"
+#include "slotmap.h"
+
+#ifdef GFS_COLLECTION_BENCH
+
+// Times the recompdata collections against this mod's own slotmap, to help choose between them for per-actor state.
+// Runs once on the first frame of gameplay and prints ns/op for each operation at each element count.
+
+u32 bBenchCounts[] = { 100, 1000, 10000, 100000, 1000000 };
+
+bool bBenchDone = false;
+
+// Keeps the results of guest-side lookups alive so they aren't optimized out.
+volatile u32 bBenchSink;
+
+// The CPU counter runs at 46.875MHz, i.e. 64 nanoseconds every 3 ticks.
+void Mod_ReportBench(const char* name, u32 count, OSTime start) {
+    u32 ticks = (u32)(osGetTime() - start);
+
+    recomp_printf("  %-28s %8u  %10.1f ns/op\n", name, count, (f32)ticks * (64.0f / 3.0f) / count);
+}
+
+void Mod_BenchValueHashmap(u32 count) {
+    U32ValueHashmapHandle map = recomputil_create_u32_value_hashmap();
+    unsigned long value;
+    OSTime start;
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_value_hashmap_insert(map, i * 7, i);
+    }
+    Mod_ReportBench("u32_value_hashmap insert", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_value_hashmap_get(map, i * 7, &value);
+    }
+    Mod_ReportBench("u32_value_hashmap get", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_value_hashmap_contains(map, i * 7);
+    }
+    Mod_ReportBench("u32_value_hashmap contains", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_value_hashmap_erase(map, i * 7);
+    }
+    Mod_ReportBench("u32_value_hashmap erase", count, start);
+
+    recomputil_destroy_u32_value_hashmap(map);
+}
+
+void Mod_BenchHashset(u32 count) {
+    U32HashsetHandle set = recomputil_create_u32_hashset();
+    OSTime start;
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_hashset_insert(set, i * 7);
+    }
+    Mod_ReportBench("u32_hashset insert", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_hashset_contains(set, i * 7);
+    }
+    Mod_ReportBench("u32_hashset contains", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_hashset_erase(set, i * 7);
+    }
+    Mod_ReportBench("u32_hashset erase", count, start);
+
+    recomputil_destroy_u32_hashset(set);
+}
+
+void Mod_BenchU32Slotmap(u32 count, collection_key_t* keys) {
+    U32SlotmapHandle map = recomputil_create_u32_slotmap();
+    unsigned long value;
+    OSTime start;
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        keys[i] = recomputil_u32_slotmap_create(map);
+    }
+    Mod_ReportBench("u32_slotmap create", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_slotmap_get(map, keys[i], &value);
+    }
+    Mod_ReportBench("u32_slotmap get", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_slotmap_contains(map, keys[i]);
+    }
+    Mod_ReportBench("u32_slotmap contains", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_u32_slotmap_erase(map, keys[i]);
+    }
+    Mod_ReportBench("u32_slotmap erase", count, start);
+
+    recomputil_destroy_u32_slotmap(map);
+}
+
+void Mod_BenchMemorySlotmap(u32 count, collection_key_t* keys) {
+    MemorySlotmapHandle map = recomputil_create_memory_slotmap(sizeof(Vec3f));
+    void* element;
+    OSTime start;
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        keys[i] = recomputil_memory_slotmap_create(map);
+    }
+    Mod_ReportBench("memory_slotmap create", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_memory_slotmap_get(map, keys[i], &element);
+    }
+    Mod_ReportBench("memory_slotmap get", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_memory_slotmap_contains(map, keys[i]);
+    }
+    Mod_ReportBench("memory_slotmap contains", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        recomputil_memory_slotmap_erase(map, keys[i]);
+    }
+    Mod_ReportBench("memory_slotmap erase", count, start);
+
+    recomputil_destroy_memory_slotmap(map);
+}
+
+// The guest slotmap's memory is never freed, so there's one map sized for the largest count it can hold.
+void Mod_BenchGuestSlotmap(Slotmap* map, u32 count, SlotmapKey* keys) {
+    void* element;
+    OSTime start;
+
+    Mod_SlotmapReset(map);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        keys[i] = Mod_SlotmapCreate(map, &element);
+    }
+    Mod_ReportBench("guest slotmap create", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        bBenchSink += (u32)Mod_SlotmapGet(map, keys[i]);
+    }
+    Mod_ReportBench("guest slotmap get", count, start);
+
+    start = osGetTime();
+    for (u32 i = 0; i < count; i++) {
+        Mod_SlotmapErase(map, keys[i]);
+    }
+    Mod_ReportBench("guest slotmap erase", count, start);
+}
+
+void Mod_RunCollectionBench() {
+    u32 maxCount = bBenchCounts[ARRAY_COUNT(bBenchCounts) - 1];
+    collection_key_t* keys = recomp_alloc(maxCount * sizeof(collection_key_t));
+    Slotmap guestMap;
+    bool guestMapValid = Mod_SlotmapInit(&guestMap, sizeof(Vec3f), 0xFFFE, false);
+
+    recomp_printf("GFS+ collection benchmark (element count, mean time per operation):\n");
+
+    for (s32 i = 0; i < ARRAY_COUNT(bBenchCounts); i++) {
+        u32 count = bBenchCounts[i];
+
+        Mod_BenchValueHashmap(count);
+        Mod_BenchHashset(count);
+        Mod_BenchU32Slotmap(count, keys);
+        Mod_BenchMemorySlotmap(count, keys);
+        if (guestMapValid && count <= guestMap.capacity) {
+            Mod_BenchGuestSlotmap(&guestMap, count, (SlotmapKey*)keys);
+        }
+    }
+
+    recomp_free(keys);
+}
+
+RECOMP_CALLBACK("*", recomp_on_play_main) void collection_bench_on_play_main(PlayState* play) {
+    if (!bBenchDone) {
+        bBenchDone = true;
+        Mod_RunCollectionBench();
+    }
+}
+
+#endif
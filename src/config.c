@@ -0,0 +1,62 @@
+#include "global.h"
+#include "modding.h"
+#include "recomputils.h"
+#include "recompconfig.h"
+#include "hook_stats.h"
+#include "config.h"
+
+// There's no event for the player changing an option, so the snapshot is refreshed this often instead.
+#define CONFIG_REFRESH_INTERVAL 20
+
+extern s32 Mod_ApplyFormItemRestrictions();
+
+// Matches the order of the border_color options in mod.toml.
+Color_RGB8 bBorderColors[] = {
+    { 100, 255, 120 }, // Green
+    { 100, 150, 255 }, // Blue
+    { 255, 100, 100 }, // Red
+    { 255, 215, 80 },  // Gold
+};
+
+GFSConfig mGFSConfig = { false, { 100, 255, 120 }, 1.0f };
+
+u32 bConfigFrames = 0;
+
+// Reads every option into the snapshot and applies any that need more than the new value being read. Returns whether
+// anything changed.
+bool Mod_RefreshConfig() {
+    GFSConfig config;
+    u32 borderColor = recomp_get_config_u32("border_color");
+
+    config.allowOtherForms = recomp_get_config_u32("allow_other_forms") != 0;
+    config.borderColor = bBorderColors[borderColor < ARRAY_COUNT(bBorderColors) ? borderColor : 0];
+    config.chargeScale = recomp_get_config_double("charge_scale");
+
+    if (config.allowOtherForms == mGFSConfig.allowOtherForms && config.borderColor.r == mGFSConfig.borderColor.r &&
+        config.borderColor.g == mGFSConfig.borderColor.g && config.borderColor.b == mGFSConfig.borderColor.b &&
+        config.chargeScale == mGFSConfig.chargeScale) {
+        return false;
+    }
+
+    bool formsChanged = config.allowOtherForms != mGFSConfig.allowOtherForms;
+
+    mGFSConfig = config;
+    if (formsChanged) {
+        Mod_ApplyFormItemRestrictions();
+    }
+
+    return true;
+}
+
+RECOMP_CALLBACK("*", recomp_on_play_main) void config_on_play_main(PlayState* play) {
+    if (++bConfigFrames < CONFIG_REFRESH_INTERVAL) {
+        return;
+    }
+    bConfigFrames = 0;
+
+    HOOK_STATS_BEGIN(HOOK_STAT_CONFIG_REFRESH);
+
+    Mod_RefreshConfig();
+
+    HOOK_STATS_END(HOOK_STAT_CONFIG_REFRESH);
+}
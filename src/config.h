@@ -0,0 +1,20 @@
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+#include "global.h"
+
+// Copy of the mod's config options. Reading an option goes through the host and looks it up by name, so hooks read these
+// fields instead, and the snapshot is only refreshed every few frames.
+typedef struct {
+    // Leaves whether forms other than human Link can use the GFS up to other mods, e.g. Forms Use More Items.
+    bool allowOtherForms;
+    Color_RGB8 borderColor;
+    // Multiplier on the size of the GFS charge effect.
+    f32 chargeScale;
+} GFSConfig;
+
+extern GFSConfig mGFSConfig;
+
+bool Mod_RefreshConfig();
+
+#endif
@@ -2,71 +2,74 @@
 #include "modding.h"
 #include "recomputils.h"
 #include "recompconfig.h"
+#include "hook_stats.h"
+#include "config.h"
+#include "equip_state.h"
 #include "overlays/kaleido_scope/ovl_kaleido_scope/z_kaleido_scope.h"
 
 extern TexturePtr gEquippedItemOutlineTex[];
 
-extern PlayState* bPlayState;
-extern bool mGFSEquipped;
+// The border quad never changes unless the GFS slot moves, so it's built once along with the display list that draws it.
+// Vertex colours are left white, as G_CC_MODULATEIA_PRIM takes both colour and alpha from the prim colour.
+// When the slot moves, the previous frame's display list may still be reading the current copy, so the quad is rebuilt
+// into the other of two copies, the same way the game double buffers its graph arena.
+Vtx bGFSBorderVtx[2][4];
+Gfx bGFSBorderDL[2][16];
+s32 bGFSBorderBuffer = 0;
+bool bGFSBorderBuilt = false;
 
-bool bKaleidoScope_DrawItemSelect = false;
+void Mod_BuildGFSBorder(Vtx* itemVtx) {
+    s16 x = itemVtx->v.ob[0] + ITEM_GRID_SELECTED_QUAD_MARGIN;
+    s16 y = itemVtx->v.ob[1] - ITEM_GRID_SELECTED_QUAD_MARGIN;
+    s16 texSize = ITEM_GRID_SELECTED_QUAD_TEX_SIZE * (1 << 5);
 
-RECOMP_HOOK("KaleidoScope_DrawItemSelect") void KaleidoScope_DrawItemSelect_Init(PlayState* play) {
-    if (mGFSEquipped == true) {
-        bKaleidoScope_DrawItemSelect = true;
+    if (bGFSBorderBuilt && bGFSBorderVtx[bGFSBorderBuffer][0].v.ob[0] == x &&
+        bGFSBorderVtx[bGFSBorderBuffer][0].v.ob[1] == y) {
+        return;
     }
+
+    bGFSBorderBuffer ^= 1;
+
+    for (s32 i = 0; i < 4; i++) {
+        Vtx* vtx = &bGFSBorderVtx[bGFSBorderBuffer][i];
+
+        vtx->v.ob[0] = x + ((i & 1) ? ITEM_GRID_SELECTED_QUAD_WIDTH : 0);
+        vtx->v.ob[1] = y - ((i & 2) ? ITEM_GRID_SELECTED_QUAD_WIDTH : 0);
+        vtx->v.ob[2] = 0;
+        vtx->v.flag = 0;
+        vtx->v.tc[0] = (i & 1) ? texSize : 0;
+        vtx->v.tc[1] = (i & 2) ? texSize : 0;
+        vtx->v.cn[0] = vtx->v.cn[1] = vtx->v.cn[2] = vtx->v.cn[3] = 255;
+    }
+
+    Gfx* gfx = bGFSBorderDL[bGFSBorderBuffer];
+    gSPVertex(gfx++, &bGFSBorderVtx[bGFSBorderBuffer][0], 4, 0);
+    gfx = Gfx_DrawTexQuadIA8(gfx, gEquippedItemOutlineTex, 32, 32, 0);
+    gSPEndDisplayList(gfx++);
+
+    bGFSBorderBuilt = true;
 }
-    
-RECOMP_HOOK_RETURN("Gfx_SetupDL42_Opa") void Gfx_SetupDL42_Opa_Return() {
-    if (bKaleidoScope_DrawItemSelect == true) {
-        PauseContext* pauseCtx = &bPlayState->pauseCtx;
-        
-        Vtx* greatFairySwordBorder = GRAPH_ALLOC(bPlayState->state.gfxCtx, (1 * 4) * sizeof(Vtx));
-
-        greatFairySwordBorder[0].v.ob[0] = greatFairySwordBorder[2].v.ob[0] =
-            pauseCtx->itemVtx[64].v.ob[0] + ITEM_GRID_SELECTED_QUAD_MARGIN;
-        
-        greatFairySwordBorder[1].v.ob[0] = greatFairySwordBorder[3].v.ob[0] =
-            greatFairySwordBorder[0].v.ob[0] + ITEM_GRID_SELECTED_QUAD_WIDTH;
-        
-        greatFairySwordBorder[0].v.ob[1] = greatFairySwordBorder[1].v.ob[1] =
-            pauseCtx->itemVtx[64].v.ob[1] - ITEM_GRID_SELECTED_QUAD_MARGIN;
-        
-        greatFairySwordBorder[2].v.ob[1] = greatFairySwordBorder[3].v.ob[1] =
-            greatFairySwordBorder[0].v.ob[1] - ITEM_GRID_SELECTED_QUAD_WIDTH;
-        
-        greatFairySwordBorder[0].v.ob[2] = greatFairySwordBorder[1].v.ob[2] = greatFairySwordBorder[2].v.ob[2] =
-            greatFairySwordBorder[3].v.ob[2] = 0;
-        
-        greatFairySwordBorder[0].v.flag = greatFairySwordBorder[1].v.flag = greatFairySwordBorder[2].v.flag =
-            greatFairySwordBorder[3].v.flag = 0;
-        
-        greatFairySwordBorder[0].v.tc[0] = greatFairySwordBorder[0].v.tc[1] = greatFairySwordBorder[1].v.tc[1] =
-            greatFairySwordBorder[2].v.tc[0] = 0;
-        
-        greatFairySwordBorder[1].v.tc[0] = greatFairySwordBorder[2].v.tc[1] = greatFairySwordBorder[3].v.tc[0] =
-            greatFairySwordBorder[3].v.tc[1] = ITEM_GRID_SELECTED_QUAD_TEX_SIZE * (1 << 5);
-        
-        greatFairySwordBorder[0].v.cn[0] = greatFairySwordBorder[1].v.cn[0] = greatFairySwordBorder[2].v.cn[0] =
-            greatFairySwordBorder[3].v.cn[0] = greatFairySwordBorder[0].v.cn[1] =
-                greatFairySwordBorder[1].v.cn[1] = greatFairySwordBorder[2].v.cn[1] =
-                    greatFairySwordBorder[3].v.cn[1] = greatFairySwordBorder[0].v.cn[2] =
-                        greatFairySwordBorder[1].v.cn[2] = greatFairySwordBorder[2].v.cn[2] =
-                            greatFairySwordBorder[3].v.cn[2] = 255;
-        
-        greatFairySwordBorder[0].v.cn[3] = greatFairySwordBorder[1].v.cn[3] = greatFairySwordBorder[2].v.cn[3] =
-            greatFairySwordBorder[3].v.cn[3] = pauseCtx->alpha;
-        
-        OPEN_DISPS(bPlayState->state.gfxCtx);
-        
+
+// Draw the border before the item grid, the same way the game draws the borders of items equipped to the C buttons,
+// so the GFS icon ends up on top of it. The game sets the same draw state up again when the function starts.
+RECOMP_HOOK("KaleidoScope_DrawItemSelect") void KaleidoScope_DrawItemSelect_Init(PlayState* play) {
+    HOOK_STATS_BEGIN(HOOK_STAT_DRAW_ITEM_SELECT);
+
+    if (mGFSEquipped == true) {
+        PauseContext* pauseCtx = &play->pauseCtx;
+
+        Mod_BuildGFSBorder(&pauseCtx->itemVtx[64]);
+        Gfx_SetupDL42_Opa(play->state.gfxCtx);
+
+        OPEN_DISPS(play->state.gfxCtx);
+
         gDPSetCombineMode(POLY_OPA_DISP++, G_CC_MODULATEIA_PRIM, G_CC_MODULATEIA_PRIM);
-        gDPSetPrimColor(POLY_OPA_DISP++, 0, 0, 100, 255, 120, pauseCtx->alpha);
-        
-        gSPVertex(POLY_OPA_DISP++, &greatFairySwordBorder[0], 4, 0);
-        POLY_OPA_DISP = Gfx_DrawTexQuadIA8(POLY_OPA_DISP, gEquippedItemOutlineTex, 32, 32, 0);
-
-        CLOSE_DISPS(bPlayState->state.gfxCtx);
-    
-        bKaleidoScope_DrawItemSelect = false;
+        gDPSetPrimColor(POLY_OPA_DISP++, 0, 0, mGFSConfig.borderColor.r, mGFSConfig.borderColor.g,
+                        mGFSConfig.borderColor.b, pauseCtx->alpha);
+        gSPDisplayList(POLY_OPA_DISP++, bGFSBorderDL[bGFSBorderBuffer]);
+
+        CLOSE_DISPS(play->state.gfxCtx);
     }
-}
\ No newline at end of file
+
+    HOOK_STATS_END(HOOK_STAT_DRAW_ITEM_SELECT);
+}
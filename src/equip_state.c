@@ -0,0 +1,161 @@
+#include "global.h"
+#include "modding.h"
+#include "recomputils.h"
+#include "recompconfig.h"
+#include "hook_stats.h"
+#include "equip_state.h"
+
+extern PlayState* bPlayState;
+
+bool mGFSEquipped = false;
+
+// Item whose icon is currently loaded into the B button, or -1 if it isn't known (e.g. on a scene load before the game
+// has loaded one).
+// Used to skip icon reloads when an event doesn't actually change what the B button shows.
+s16 bLoadedBButtonItem = -1;
+
+// Button passed to the Interface_LoadItemIconImpl call in progress.
+u8 bLoadingIconButton;
+
+// Item the B button holds when the GFS isn't equipped.
+u8 Mod_GetSwordItem() {
+    if (GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD) == EQUIP_VALUE_SWORD_NONE) {
+        return ITEM_NONE;
+    }
+    return ITEM_SWORD_KOKIRI - 1 + GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD);
+}
+
+// Works out the equip state after an event. Only depends on its arguments, so it doesn't touch the save context and can
+// be compiled and exercised on its own.
+GFSEquipState Mod_ResolveGFSEquip(GFSEquipState state, GFSEquipEvent event, u8 swordItem) {
+    switch (event) {
+        case GFS_EVENT_PAUSE_EQUIP:
+            // As Fierce Deity, toggle whether the GFS comes back once the Deity's Sword is taken off.
+            if (state.bButtonItem == ITEM_SWORD_DEITY) {
+                state.equipped = !state.equipped;
+            } else if (state.bButtonItem != ITEM_SWORD_GREAT_FAIRY) {
+                state.bButtonItem = ITEM_SWORD_GREAT_FAIRY;
+                state.equipped = true;
+            } else {
+                state.bButtonItem = swordItem;
+                state.equipped = false;
+            }
+            break;
+
+        case GFS_EVENT_B_BUTTON_RELOAD:
+            // Keep GFS equipped if the B button is contextually changed back to a normal sword.
+            if (state.equipped && ((ITEM_SWORD_KOKIRI <= state.bButtonItem && state.bButtonItem <= ITEM_SWORD_GILDED) ||
+                state.bButtonItem == ITEM_NONE)) {
+                state.bButtonItem = ITEM_SWORD_GREAT_FAIRY;
+            }
+            break;
+
+        case GFS_EVENT_GFS_STOLEN:
+            if (state.equipped) {
+                state.bButtonItem = swordItem;
+                state.equipped = false;
+            }
+            break;
+
+        case GFS_EVENT_SWORD_STOLEN:
+            if (state.equipped) {
+                state.bButtonItem = ITEM_SWORD_GREAT_FAIRY;
+            }
+            break;
+
+        case GFS_EVENT_DEITY_UPDATE:
+            if (state.equipped && state.bButtonItem != ITEM_SWORD_DEITY) {
+                state.bButtonItem = ITEM_SWORD_GREAT_FAIRY;
+            }
+            break;
+
+        case GFS_EVENT_B_BUTTON_CLEARED:
+            if (state.equipped && state.bButtonItem == ITEM_NONE) {
+                state.bButtonItem = ITEM_SWORD_GREAT_FAIRY;
+            }
+            break;
+    }
+
+    return state;
+}
+
+#ifdef GFS_EQUIP_CHECKS
+const char* bGFSEquipEventNames[] = {
+    "PAUSE_EQUIP", "B_BUTTON_RELOAD", "GFS_STOLEN", "SWORD_STOLEN", "DEITY_UPDATE", "B_BUTTON_CLEARED",
+};
+
+// Reports equip states that no sequence of events should be able to reach.
+void Mod_CheckGFSEquipState(GFSEquipState before, GFSEquipState after, GFSEquipEvent event) {
+    bool valid;
+
+    if (after.equipped) {
+        // Normal swords are always replaced by the GFS while it's equipped.
+        valid = !(ITEM_SWORD_KOKIRI <= after.bButtonItem && after.bButtonItem <= ITEM_SWORD_GILDED);
+    } else {
+        valid = after.bButtonItem != ITEM_SWORD_GREAT_FAIRY;
+    }
+
+    if (!valid) {
+        recomp_printf("GFS+ equip state invalid after %s: equipped %d -> %d, B button 0x%02X -> 0x%02X\n",
+                      bGFSEquipEventNames[event], before.equipped, after.equipped, before.bButtonItem, after.bButtonItem);
+    }
+}
+#endif
+
+void Mod_GFSEquipEvent(GFSEquipEvent event) {
+    GFSEquipState before = { mGFSEquipped, BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) };
+    GFSEquipState state = Mod_ResolveGFSEquip(before, event, Mod_GetSwordItem());
+
+#ifdef GFS_EQUIP_CHECKS
+    Mod_CheckGFSEquipState(before, state, event);
+#endif
+
+    if (state.equipped == before.equipped && state.bButtonItem == before.bButtonItem) {
+        return;
+    }
+
+    mGFSEquipped = state.equipped;
+    BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = state.bButtonItem;
+
+    // On a reload event the game loads the icon itself straight afterwards. The game never loads an icon for an empty
+    // button, so neither does this.
+    if (event != GFS_EVENT_B_BUTTON_RELOAD && GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B) < ITEM_F0 &&
+        GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B) != bLoadedBButtonItem) {
+        Mod_LoadBButtonIcon(bPlayState);
+    }
+}
+
+// The icon segment is reallocated here on every play init, so whatever was loaded into the B button before is gone. The
+// game loads the new B icon later on in Interface_Init, through the hook below.
+RECOMP_HOOK("Interface_Init") void Interface_Init_Init(PlayState* play) {
+    HOOK_STATS_BEGIN(HOOK_STAT_INTERFACE_INIT);
+
+    bLoadedBButtonItem = -1;
+
+    HOOK_STATS_END(HOOK_STAT_INTERFACE_INIT);
+}
+
+// Keep GFS equipped if the B button item is changed back to a normal sword contextually e.g. dismounting Epona or
+// unlocking a new sword. The game always reloads the B button icon after writing a new item to it, so this is where
+// those transitions are picked up, along with the icon loads done by Mod_GFSEquipEvent itself.
+RECOMP_HOOK("Interface_LoadItemIconImpl") void Interface_LoadItemIconImpl_Init(PlayState* play, u8 btn) {
+    HOOK_STATS_BEGIN(HOOK_STAT_LOAD_ITEM_ICON_IMPL_INIT);
+
+    bLoadingIconButton = btn;
+    if (btn == EQUIP_SLOT_B) {
+        Mod_GFSEquipEvent(GFS_EVENT_B_BUTTON_RELOAD);
+    }
+
+    HOOK_STATS_END(HOOK_STAT_LOAD_ITEM_ICON_IMPL_INIT);
+}
+
+// Records the loaded item once the load is done, as other mods' hooks may still change the B button after this mod's.
+RECOMP_HOOK_RETURN("Interface_LoadItemIconImpl") void Interface_LoadItemIconImpl_Return() {
+    HOOK_STATS_BEGIN(HOOK_STAT_LOAD_ITEM_ICON_IMPL_RETURN);
+
+    if (bLoadingIconButton == EQUIP_SLOT_B) {
+        bLoadedBButtonItem = GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B);
+    }
+
+    HOOK_STATS_END(HOOK_STAT_LOAD_ITEM_ICON_IMPL_RETURN);
+}
@@ -0,0 +1,36 @@
+#ifndef __EQUIP_STATE_H__
+#define __EQUIP_STATE_H__
+
+#include "global.h"
+
+// Transitions that can change what the B button should hold while the GFS is equipped.
+typedef enum {
+    // GFS was selected on the item select screen.
+    GFS_EVENT_PAUSE_EQUIP,
+    // The game is about to load the B button icon after writing a new item to it e.g. receiving a sword, dismounting Epona.
+    GFS_EVENT_B_BUTTON_RELOAD,
+    // Takkuri stole the GFS.
+    GFS_EVENT_GFS_STOLEN,
+    // Takkuri stole the player's sword.
+    GFS_EVENT_SWORD_STOLEN,
+    // Fierce Deity's Sword was put on or taken off the B button.
+    GFS_EVENT_DEITY_UPDATE,
+    // The game emptied the B button without loading an icon, e.g. dismounting Epona without a sword.
+    GFS_EVENT_B_BUTTON_CLEARED
+} GFSEquipEvent;
+
+typedef struct {
+    bool equipped;
+    u8 bButtonItem;
+} GFSEquipState;
+
+extern bool mGFSEquipped;
+// Item whose icon is currently loaded into the B button, or -1 if it isn't known.
+extern s16 bLoadedBButtonItem;
+
+GFSEquipState Mod_ResolveGFSEquip(GFSEquipState state, GFSEquipEvent event, u8 swordItem);
+void Mod_GFSEquipEvent(GFSEquipEvent event);
+// Defined in icon_cache.c.
+void Mod_LoadBButtonIcon(PlayState* play);
+
+#endif
@@ -2,21 +2,11 @@
 #include "modding.h"
 #include "recomputils.h"
 #include "recompconfig.h"
+#include "hook_stats.h"
+#include "equip_state.h"
 
 extern PlayState* bPlayState;
 
-bool mGFSEquipped = false;
-
-void Mod_UnequipGFS() {
-    if (GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD) == EQUIP_VALUE_SWORD_NONE) {
-        BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_NONE;
-    } else {
-        BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_SWORD_KOKIRI - 1 + GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD);
-    }
-    Interface_LoadItemIconImpl(bPlayState, EQUIP_SLOT_B);
-    mGFSEquipped = false;
-}
-
 // Allow GFS to be equipped if player presses button a mask is being worn on.
 // Value of 255 means that Player_GetCurMaskItemId isn't being called in KaleidoScope_UpdateItemCursor.
 // Value of PLAYER_MASK_MAX means that it is.
@@ -25,55 +15,66 @@ u8 bCurrentMask = 255;
 u8 bCurrentForm = PLAYER_FORM_MAX;
 
 RECOMP_HOOK("KaleidoScope_UpdateItemCursor") void KaleidoScope_UpdateItemCursor_Init(PlayState* play) {
+    HOOK_STATS_BEGIN(HOOK_STAT_UPDATE_ITEM_CURSOR_INIT);
+
     bCurrentMask = PLAYER_MASK_MAX;
     
     bCurrentForm = GET_PLAYER_FORM;
     gSaveContext.save.playerForm = PLAYER_FORM_HUMAN;
+
+    HOOK_STATS_END(HOOK_STAT_UPDATE_ITEM_CURSOR_INIT);
 }
 
 RECOMP_HOOK("Player_GetCurMaskItemId") void Player_GetCurMaskItemId_Init(PlayState* play) {
+    HOOK_STATS_BEGIN(HOOK_STAT_GET_CUR_MASK_ITEM_ID_INIT);
+
     if (bCurrentMask == PLAYER_MASK_MAX && (&play->pauseCtx)->cursorItem[PAUSE_ITEM] == ITEM_SWORD_GREAT_FAIRY) {
         Player* player = GET_PLAYER(play);
         
         bCurrentMask = player->currentMask;
         player->currentMask = PLAYER_MASK_NONE;
     }
+
+    HOOK_STATS_END(HOOK_STAT_GET_CUR_MASK_ITEM_ID_INIT);
 }
 
 RECOMP_HOOK_RETURN("Player_GetCurMaskItemId") void Player_GetCurMaskItemId_Return() {
+    HOOK_STATS_BEGIN(HOOK_STAT_GET_CUR_MASK_ITEM_ID_RETURN);
+
     if (bCurrentMask != 255 && (&bPlayState->pauseCtx)->cursorItem[PAUSE_ITEM] == ITEM_SWORD_GREAT_FAIRY) {
         Player* player = GET_PLAYER(bPlayState);
         
         player->currentMask = bCurrentMask;
         bCurrentMask = PLAYER_MASK_MAX;
     }
+
+    HOOK_STATS_END(HOOK_STAT_GET_CUR_MASK_ITEM_ID_RETURN);
 }
 
 RECOMP_HOOK_RETURN("KaleidoScope_UpdateItemCursor") void KaleidoScope_UpdateItemCursor_Return() {
+    HOOK_STATS_BEGIN(HOOK_STAT_UPDATE_ITEM_CURSOR_RETURN);
+
     PauseContext* pauseCtx = &bPlayState->pauseCtx;
+
+    // Put the form back first, so the equip event sees which B button is actually shown and doesn't load the GFS icon
+    // over a transformation's B button.
+    gSaveContext.save.playerForm = bCurrentForm;
     
     // Main equip logic.
     if (pauseCtx->mainState == PAUSE_MAIN_STATE_EQUIP_ITEM && pauseCtx->equipTargetItem == ITEM_SWORD_GREAT_FAIRY) {
         pauseCtx->mainState = PAUSE_MAIN_STATE_IDLE;
-        
-        if (BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) == ITEM_SWORD_DEITY) {
-            mGFSEquipped = !mGFSEquipped;
-        } else if (BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) != ITEM_SWORD_GREAT_FAIRY) {
-            BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_SWORD_GREAT_FAIRY;
-            Interface_LoadItemIconImpl(bPlayState, EQUIP_SLOT_B);
-            mGFSEquipped = true;
-        } else {
-            Mod_UnequipGFS();
-        }
+        Mod_GFSEquipEvent(GFS_EVENT_PAUSE_EQUIP);
     }
 
-    gSaveContext.save.playerForm = bCurrentForm;
     bCurrentMask = 255;
+
+    HOOK_STATS_END(HOOK_STAT_UPDATE_ITEM_CURSOR_RETURN);
 }
 
 RECOMP_HOOK_RETURN("Inventory_UpdateDeitySwordEquip") void Inventory_UpdateDeitySwordEquip_Return() {
-    if (mGFSEquipped == true && BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) != ITEM_SWORD_DEITY) {
-        BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_SWORD_GREAT_FAIRY;
-        Interface_LoadItemIconImpl(bPlayState, EQUIP_SLOT_B);
-    }
+    HOOK_STATS_BEGIN(HOOK_STAT_UPDATE_DEITY_SWORD_EQUIP_RETURN);
+
+    Mod_GFSEquipEvent(GFS_EVENT_DEITY_UPDATE);
+
+    HOOK_STATS_END(HOOK_STAT_UPDATE_DEITY_SWORD_EQUIP_RETURN);
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "global.h"
+#include "modding.h"
+#include "recomputils.h"
+#include "recompconfig.h"
+#include "hook_stats.h"
+
+#ifdef GFS_HOOK_STATS
+
+// Number of frames to accumulate before printing the stats.
+#define HOOK_STATS_INTERVAL 600
+
+// Per-frame time histogram buckets: not called, then under 1, 2, 4, 8, 16 and 32 microseconds, then anything slower.
+#define HOOK_STATS_BUCKETS 8
+
+typedef struct {
+    u32 calls;
+    // Times are in CPU counter ticks, kept as u32 to avoid 64-bit division.
+    u32 totalTime;
+    u32 minTime;
+    u32 maxTime;
+    u32 frameTime;
+    bool frameCalled;
+    u32 histogram[HOOK_STATS_BUCKETS];
+} HookStat;
+
+const char* bHookStatNames[HOOK_STAT_MAX] = {
+    [HOOK_STAT_AFTER_PLAY_INIT] = "after_play_init",
+    [HOOK_STAT_UPDATE_ITEM_CURSOR_INIT] = "KaleidoScope_UpdateItemCursor",
+    [HOOK_STAT_UPDATE_ITEM_CURSOR_RETURN] = "KaleidoScope_UpdateItemCursor ret",
+    [HOOK_STAT_GET_CUR_MASK_ITEM_ID_INIT] = "Player_GetCurMaskItemId",
+    [HOOK_STAT_GET_CUR_MASK_ITEM_ID_RETURN] = "Player_GetCurMaskItemId ret",
+    [HOOK_STAT_UPDATE_DEITY_SWORD_EQUIP_RETURN] = "Inventory_UpdateDeitySwordEquip ret",
+    [HOOK_STAT_LOAD_ITEM_ICON_IMPL_INIT] = "Interface_LoadItemIconImpl",
+    [HOOK_STAT_LOAD_ITEM_ICON_IMPL_RETURN] = "Interface_LoadItemIconImpl ret",
+    [HOOK_STAT_INTERFACE_INIT] = "Interface_Init",
+    [HOOK_STAT_UPDATE_BUTTONS_PART2_RETURN] = "Interface_UpdateButtonsPart2 ret",
+    [HOOK_STAT_FUNC_80C10B0C_INIT] = "func_80C10B0C",
+    [HOOK_STAT_FUNC_80C10B0C_RETURN] = "func_80C10B0C ret",
+    [HOOK_STAT_DELETE_ITEM_INIT] = "Inventory_DeleteItem",
+    [HOOK_STAT_EN_M_THUNDER_DRAW_INIT] = "EnMThunder_Draw",
+    [HOOK_STAT_EN_M_THUNDER_DRAW_RETURN] = "EnMThunder_Draw ret",
+    [HOOK_STAT_MATRIX_ROTATE_XS] = "Matrix_RotateXS",
+    [HOOK_STAT_CHARGE_SCALE] = "GFS charge scale",
+    [HOOK_STAT_DRAW_ITEM_SELECT] = "KaleidoScope_DrawItemSelect",
+    [HOOK_STAT_GFS_CHANGE_MSG] = "GFS_change",
+    [HOOK_STAT_CONFIG_REFRESH] = "config refresh",
+};
+
+HookStat bHookStats[HOOK_STAT_MAX];
+u32 bHookStatFrames = 0;
+
+// The CPU counter runs at 46.875MHz, i.e. 375 ticks every 8 microseconds.
+u32 Mod_HookTicksToUsec(u32 ticks) {
+    return (ticks / 375) * 8 + ((ticks % 375) * 8) / 375;
+}
+
+u32 Mod_HookTicksToNsec(u32 ticks) {
+    return (ticks / 3) * 64 + ((ticks % 3) * 64) / 3;
+}
+
+void Mod_CountHookStat(HookStatId id) {
+    bHookStats[id].calls++;
+    bHookStats[id].frameCalled = true;
+}
+
+void Mod_RecordHookStat(HookStatId id, OSTime start) {
+    HookStat* stat = &bHookStats[id];
+    u32 time = (u32)(osGetTime() - start);
+
+    if (stat->calls == 0 || time < stat->minTime) {
+        stat->minTime = time;
+    }
+    if (time > stat->maxTime) {
+        stat->maxTime = time;
+    }
+    stat->calls++;
+    stat->totalTime += time;
+    stat->frameTime += time;
+    stat->frameCalled = true;
+}
+
+void Mod_PrintHookStats() {
+    recomp_printf("GFS+ hook stats over %u frames (min/mean/max in ns, frame histogram: none <1 <2 <4 <8 <16 <32 >=32 us):\n",
+                  bHookStatFrames);
+
+    for (s32 i = 0; i < HOOK_STAT_MAX; i++) {
+        HookStat* stat = &bHookStats[i];
+        u32* hist = stat->histogram;
+
+        if (stat->calls == 0) {
+            continue;
+        }
+
+        recomp_printf("  %-36s %8u calls (%u/frame) %6u/%6u/%6u | %u %u %u %u %u %u %u %u\n", bHookStatNames[i],
+                      stat->calls, stat->calls / bHookStatFrames, Mod_HookTicksToNsec(stat->minTime),
+                      Mod_HookTicksToNsec(stat->totalTime / stat->calls), Mod_HookTicksToNsec(stat->maxTime), hist[0],
+                      hist[1], hist[2], hist[3], hist[4], hist[5], hist[6], hist[7]);
+    }
+}
+
+RECOMP_CALLBACK("*", recomp_on_play_main) void hook_stats_on_play_main(PlayState* play) {
+    for (s32 i = 0; i < HOOK_STAT_MAX; i++) {
+        HookStat* stat = &bHookStats[i];
+        s32 bucket = 0;
+
+        if (stat->frameCalled) {
+            u32 usec = Mod_HookTicksToUsec(stat->frameTime);
+
+            bucket = 1;
+            while (bucket < HOOK_STATS_BUCKETS - 1 && usec >= (1u << (bucket - 1))) {
+                bucket++;
+            }
+        }
+        stat->histogram[bucket]++;
+        stat->frameTime = 0;
+        stat->frameCalled = false;
+    }
+
+    if (++bHookStatFrames < HOOK_STATS_INTERVAL) {
+        return;
+    }
+
+    Mod_PrintHookStats();
+    bzero(bHookStats, sizeof(bHookStats));
+    bHookStatFrames = 0;
+}
+
+#endif
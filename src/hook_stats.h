@@ -0,0 +1,48 @@
+#ifndef __HOOK_STATS_H__
+#define __HOOK_STATS_H__
+
+#include "global.h"
+
+// Opt-in profiler for the mod's hooks. Build with `make HOOK_STATS=1` to enable it. Every hook records its call count and
+// how long it took (including anything it calls), which gets printed periodically along with a histogram of the time
+// each hook took per frame.
+typedef enum {
+    HOOK_STAT_AFTER_PLAY_INIT,
+    HOOK_STAT_UPDATE_ITEM_CURSOR_INIT,
+    HOOK_STAT_UPDATE_ITEM_CURSOR_RETURN,
+    HOOK_STAT_GET_CUR_MASK_ITEM_ID_INIT,
+    HOOK_STAT_GET_CUR_MASK_ITEM_ID_RETURN,
+    HOOK_STAT_UPDATE_DEITY_SWORD_EQUIP_RETURN,
+    HOOK_STAT_LOAD_ITEM_ICON_IMPL_INIT,
+    HOOK_STAT_LOAD_ITEM_ICON_IMPL_RETURN,
+    HOOK_STAT_INTERFACE_INIT,
+    HOOK_STAT_UPDATE_BUTTONS_PART2_RETURN,
+    HOOK_STAT_FUNC_80C10B0C_INIT,
+    HOOK_STAT_FUNC_80C10B0C_RETURN,
+    HOOK_STAT_DELETE_ITEM_INIT,
+    HOOK_STAT_EN_M_THUNDER_DRAW_INIT,
+    HOOK_STAT_EN_M_THUNDER_DRAW_RETURN,
+    HOOK_STAT_MATRIX_ROTATE_XS,
+    HOOK_STAT_CHARGE_SCALE,
+    HOOK_STAT_DRAW_ITEM_SELECT,
+    HOOK_STAT_GFS_CHANGE_MSG,
+    HOOK_STAT_CONFIG_REFRESH,
+    HOOK_STAT_MAX
+} HookStatId;
+
+#ifdef GFS_HOOK_STATS
+void Mod_RecordHookStat(HookStatId id, OSTime start);
+void Mod_CountHookStat(HookStatId id);
+
+// Place HOOK_STATS_BEGIN at the top of a hook and HOOK_STATS_END before it returns.
+#define HOOK_STATS_BEGIN(id) OSTime hookStatStart = osGetTime()
+#define HOOK_STATS_END(id) Mod_RecordHookStat(id, hookStatStart)
+// Counts something that isn't worth timing on its own.
+#define HOOK_STATS_COUNT(id) Mod_CountHookStat(id)
+#else
+#define HOOK_STATS_BEGIN(id) ((void)0)
+#define HOOK_STATS_END(id) ((void)0)
+#define HOOK_STATS_COUNT(id) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+#include "global.h"
+#include "modding.h"
+#include "recomputils.h"
+#include "recompconfig.h"
+#include "equip_state.h"
+
+// Size of a single 32x32 RGBA32 item icon in the icon item segment.
+#define ICON_ITEM_SIZE 0x1000
+
+// Items that get swapped in and out of the B button by this mod.
+u8 bIconCacheItems[] = {
+    ITEM_SWORD_GREAT_FAIRY, ITEM_SWORD_KOKIRI, ITEM_SWORD_RAZOR, ITEM_SWORD_GILDED, ITEM_SWORD_DEITY,
+};
+
+// Decompressed icons, filled the first time each one is loaded. Icons never change, so they stay valid across play sessions.
+u8 bIconCache[ARRAY_COUNT(bIconCacheItems)][ICON_ITEM_SIZE] __attribute__((aligned(8)));
+bool bIconCached[ARRAY_COUNT(bIconCacheItems)];
+
+s32 Mod_GetIconCacheIndex(u8 item) {
+    for (s32 i = 0; i < ARRAY_COUNT(bIconCacheItems); i++) {
+        if (bIconCacheItems[i] == item) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Loads the B button icon, copying it out of the cache instead of decompressing it from ROM again where possible.
+void Mod_LoadBButtonIcon(PlayState* play) {
+    u8* bButtonIcon = (u8*)play->interfaceCtx.iconItemSegment + EQUIP_SLOT_B * ICON_ITEM_SIZE;
+    s32 index = Mod_GetIconCacheIndex(GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B));
+    u8 loadedItem;
+
+    if (index >= 0 && bIconCached[index]) {
+        Lib_MemCpy(bButtonIcon, bIconCache[index], ICON_ITEM_SIZE);
+        bLoadedBButtonItem = bIconCacheItems[index];
+        return;
+    }
+
+    Interface_LoadItemIconImpl(play, EQUIP_SLOT_B);
+
+    // Hooks on the load, this mod's or another's, may have swapped the item, so cache whatever actually ended up in the
+    // B button once it's done.
+    loadedItem = GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B);
+    bLoadedBButtonItem = loadedItem;
+    index = Mod_GetIconCacheIndex(loadedItem);
+    if (index >= 0) {
+        Lib_MemCpy(bIconCache[index], bButtonIcon, ICON_ITEM_SIZE);
+        bIconCached[index] = true;
+    }
+}
@@ -2,54 +2,91 @@
 #include "modding.h"
 #include "recomputils.h"
 #include "recompconfig.h"
+#include "hook_stats.h"
+#include "equip_state.h"
+#include "config.h"
+#include "slotmap.h"
 
 extern u8 gPlayerFormItemRestrictions[PLAYER_FORM_MAX][114];
 
-extern bool mGFSEquipped;
-
 PlayState* bPlayState;
 
+typedef struct {
+    PlayerTransformation form;
+    u8 item;
+    u8 allowed;
+    // Whether the table entry has been overwritten, and what it held before that.
+    bool overridden;
+    u8 original;
+} FormItemRestrictionRule;
+
+// Compatibility with Forms Use More Items - disable GFS for all forms except humans (who wants to use GFS as Deku anyways?)
+// Unless the allow_other_forms option is on, in which case the table is left to the other mod.
+FormItemRestrictionRule bFormItemRestrictionRules[] = {
+    { PLAYER_FORM_FIERCE_DEITY, ITEM_SWORD_GREAT_FAIRY, false, false, 0 },
+    { PLAYER_FORM_GORON, ITEM_SWORD_GREAT_FAIRY, false, false, 0 },
+    { PLAYER_FORM_ZORA, ITEM_SWORD_GREAT_FAIRY, false, false, 0 },
+    { PLAYER_FORM_DEKU, ITEM_SWORD_GREAT_FAIRY, false, false, 0 },
+};
+
+// Writes any rules that aren't currently in effect, e.g. because another mod has changed the table since they were last
+// applied. If the config lets other forms use the GFS, puts back whatever the rules replaced instead. Returns the number
+// of table entries that had to be written.
+s32 Mod_ApplyFormItemRestrictions() {
+    s32 applied = 0;
+
+    for (s32 i = 0; i < ARRAY_COUNT(bFormItemRestrictionRules); i++) {
+        FormItemRestrictionRule* rule = &bFormItemRestrictionRules[i];
+        u8* entry = &gPlayerFormItemRestrictions[rule->form][rule->item];
+
+        if (mGFSConfig.allowOtherForms) {
+            if (rule->overridden) {
+                *entry = rule->original;
+                rule->overridden = false;
+                applied++;
+            }
+        } else if (*entry != rule->allowed) {
+            if (!rule->overridden) {
+                rule->original = *entry;
+                rule->overridden = true;
+            }
+            *entry = rule->allowed;
+            applied++;
+        }
+    }
+
+    return applied;
+}
+
+RECOMP_CALLBACK("*", recomp_on_init) void on_init() {
+    Mod_RefreshConfig();
+    Mod_ApplyFormItemRestrictions();
+}
+
 RECOMP_CALLBACK("*", recomp_after_play_init) void after_play_init(PlayState* this) {
+    HOOK_STATS_BEGIN(HOOK_STAT_AFTER_PLAY_INIT);
+
     // Save PlayState to be used throughout the mod.
     bPlayState = this;
-    
-    // Compatibility with Forms Use More Items - disable GFS for all forms except humans (who wants to use GFS as Deku anyways?)
-    for (PlayerTransformation i = PLAYER_FORM_FIERCE_DEITY; i < PLAYER_FORM_HUMAN; i++) {
-        gPlayerFormItemRestrictions[i][ITEM_SWORD_GREAT_FAIRY] = false;
-    }
-}
 
-// Keep GFS equipped if B button item is changed back to normal sword contextually e.g. dismounting Epona.
-// Does this by checking if the item at the beginning of the function is different to the item at the end and
-// whether the item at the end is a sword. 
-u8 bBButtonItemEquip;
+    // Per-scene state from the previous scene refers to actors that no longer exist.
+    Mod_ResetSceneSlotmaps();
 
-RECOMP_HOOK("Interface_UpdateButtonsPart2") void Interface_UpdateButtonsPart2_Init(PlayState* play) {
-    bBButtonItemEquip = BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B);
-}
+    // Only rewrites anything if another mod has reverted the rules since mod init.
+    Mod_ApplyFormItemRestrictions();
 
-RECOMP_HOOK_RETURN("Interface_UpdateButtonsPart2") void Interface_UpdateButtonsPart2_Return() {
-    if (mGFSEquipped && BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) != bBButtonItemEquip &&
-        ((ITEM_SWORD_KOKIRI <= BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) && BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) <= ITEM_SWORD_DEITY) ||
-        BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) == ITEM_NONE)) {
-            BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_SWORD_GREAT_FAIRY;
-            Interface_LoadItemIconImpl(bPlayState, EQUIP_SLOT_B);
-        }
+    HOOK_STATS_END(HOOK_STAT_AFTER_PLAY_INIT);
 }
 
-// Keep GFS equipped after unlocking a new sword.
-// Mark mGiveSword as true if unlocking a new sword, and before the B button item icon is loaded, set it back to GFS.
-bool mGiveSword = false;
+// Keep GFS equipped when the B button is emptied contextually e.g. dismounting Epona without a sword. The game doesn't
+// load an icon for an empty button, so the Interface_LoadItemIconImpl hook never sees this. B is only ever empty while
+// the GFS is equipped right after such a change, so every other frame this is just the check.
+RECOMP_HOOK_RETURN("Interface_UpdateButtonsPart2") void Interface_UpdateButtonsPart2_Return() {
+    HOOK_STATS_BEGIN(HOOK_STAT_UPDATE_BUTTONS_PART2_RETURN);
 
-RECOMP_HOOK("Item_Give") void Item_Give_Init(PlayState* play, u8 item) {
-    if (ITEM_SWORD_KOKIRI <= item && item <= ITEM_SWORD_GILDED && mGFSEquipped == true) {
-        mGiveSword = true;
+    if (mGFSEquipped && BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) == ITEM_NONE) {
+        Mod_GFSEquipEvent(GFS_EVENT_B_BUTTON_CLEARED);
     }
-}
 
-RECOMP_HOOK("Interface_LoadItemIconImpl") void Interface_LoadItemIconImpl_Init(PlayState* play, u8 btn) {
-    if (mGiveSword == true) {
-        BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_SWORD_GREAT_FAIRY;
-        mGiveSword = false;
-    }
+    HOOK_STATS_END(HOOK_STAT_UPDATE_BUTTONS_PART2_RETURN);
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "global.h"
+#include "modding.h"
+#include "recomputils.h"
+#include "recompconfig.h"
+#include "slotmap.h"
+
+#define SLOTMAP_NO_SLOT 0xFFFF
+#define SLOTMAP_MAX_SCENE_MAPS 8
+
+#define SLOTMAP_KEY(index, generation) (((u32)(generation) << 16) | (index))
+#define SLOTMAP_KEY_INDEX(key) ((key) & 0xFFFF)
+#define SLOTMAP_KEY_GENERATION(key) ((key) >> 16)
+
+Slotmap* bSceneSlotmaps[SLOTMAP_MAX_SCENE_MAPS];
+s32 bSceneSlotmapCount = 0;
+
+bool Mod_SlotmapInit(Slotmap* map, u32 elementSize, u32 capacity, bool sceneLifetime) {
+    if (capacity >= SLOTMAP_NO_SLOT || (sceneLifetime && bSceneSlotmapCount >= SLOTMAP_MAX_SCENE_MAPS)) {
+        return false;
+    }
+
+    // Refuse element sizes that would take the block size past a u32 once aligned, rather than under-allocating.
+    if (capacity != 0 && elementSize > ((0xFFFFFFFF / capacity - sizeof(u16) * 2) & ~7)) {
+        return false;
+    }
+
+    // Keep every element 8-byte aligned, as the block itself is.
+    elementSize = ALIGN8(elementSize);
+
+    u8* block = recomp_alloc(capacity * (elementSize + sizeof(u16) * 2));
+    if (block == NULL) {
+        return false;
+    }
+
+    map->elements = block;
+    map->generations = (u16*)(block + capacity * elementSize);
+    map->nextFree = map->generations + capacity;
+    map->elementSize = elementSize;
+    map->capacity = capacity;
+    bzero(map->generations, capacity * sizeof(u16));
+    Mod_SlotmapReset(map);
+
+    if (sceneLifetime) {
+        bSceneSlotmaps[bSceneSlotmapCount++] = map;
+    }
+
+    return true;
+}
+
+SlotmapKey Mod_SlotmapCreate(Slotmap* map, void** out) {
+    u32 index;
+
+    // Reuse erased slots first so the live elements stay packed at the start of the block.
+    if (map->freeHead != SLOTMAP_NO_SLOT) {
+        index = map->freeHead;
+        map->freeHead = map->nextFree[index];
+    } else if (map->highWater < map->capacity) {
+        index = map->highWater++;
+    } else {
+        return SLOTMAP_KEY_NONE;
+    }
+
+    // Move to the next odd generation. A slot left live by a reset is already odd, so it skips ahead by two to make sure
+    // keys from before the reset don't match. Generations wrap after 32768 reuses of the same slot.
+    u16* generation = &map->generations[index];
+    *generation += (*generation & 1) ? 2 : 1;
+
+    map->count++;
+    *out = map->elements + index * map->elementSize;
+    bzero(*out, map->elementSize);
+    return SLOTMAP_KEY(index, *generation);
+}
+
+void* Mod_SlotmapGet(Slotmap* map, SlotmapKey key) {
+    u32 index = SLOTMAP_KEY_INDEX(key);
+
+    if (index >= map->highWater || map->generations[index] != SLOTMAP_KEY_GENERATION(key)) {
+        return NULL;
+    }
+    return map->elements + index * map->elementSize;
+}
+
+bool Mod_SlotmapErase(Slotmap* map, SlotmapKey key) {
+    u32 index = SLOTMAP_KEY_INDEX(key);
+
+    if (Mod_SlotmapGet(map, key) == NULL) {
+        return false;
+    }
+
+    map->generations[index]++;
+    map->nextFree[index] = map->freeHead;
+    map->freeHead = index;
+    map->count--;
+    return true;
+}
+
+// Only slots below highWater can be live, and erased slots are reused first, so this is proportional to the number of
+// elements rather than the capacity.
+void* Mod_SlotmapNext(Slotmap* map, u32* cursor, SlotmapKey* key) {
+    for (u32 index = *cursor; index < map->highWater; index++) {
+        u16 generation = map->generations[index];
+
+        if (generation & 1) {
+            *cursor = index + 1;
+            *key = SLOTMAP_KEY(index, generation);
+            return map->elements + index * map->elementSize;
+        }
+    }
+
+    *cursor = map->highWater;
+    return NULL;
+}
+
+u32 Mod_SlotmapSnapshot(Slotmap* map, SlotmapKey* keys, void* elements, u32 maxCount) {
+    u32 cursor = 0;
+    u32 copied = 0;
+    void* element;
+
+    while (copied < maxCount && (element = Mod_SlotmapNext(map, &cursor, &keys[copied])) != NULL) {
+        if (elements != NULL) {
+            Lib_MemCpy((u8*)elements + copied * map->elementSize, element, map->elementSize);
+        }
+        copied++;
+    }
+
+    return copied;
+}
+
+// Only the bookkeeping is reset. Slots are validated against highWater, so their generations can be left as they are.
+void Mod_SlotmapReset(Slotmap* map) {
+    map->count = 0;
+    map->highWater = 0;
+    map->freeHead = SLOTMAP_NO_SLOT;
+}
+
+void Mod_ResetSceneSlotmaps() {
+    for (s32 i = 0; i < bSceneSlotmapCount; i++) {
+        Mod_SlotmapReset(bSceneSlotmaps[i]);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef __SLOTMAP_H__
+#define __SLOTMAP_H__
+
+#include "global.h"
+
+// Fixed-capacity slotmap for per-actor or per-message state. Unlike the slotmaps in recompdata.h, every element lives in
+// one block of guest memory reserved when the map is set up, so creating and erasing elements never allocates and never
+// crosses into the host. Keys hold a slot index and a generation, so a key stops being valid once its element is erased
+// or the map is reset, even if the slot has been reused since.
+typedef u32 SlotmapKey;
+
+// Never returned for a valid element.
+#define SLOTMAP_KEY_NONE 0
+
+typedef struct {
+    u8* elements;
+    // Odd while the slot holds an element, even while it's free.
+    u16* generations;
+    u16* nextFree;
+    u32 elementSize;
+    u32 capacity;
+    u32 count;
+    // Slots at or above this have never been handed out since the last reset.
+    u32 highWater;
+    u16 freeHead;
+} Slotmap;
+
+// Reserves room for `capacity` elements (at most 0xFFFE). Maps with a scene lifetime are reset on every play init.
+// Returns false if the block wouldn't fit in a u32 or couldn't be allocated, or if too many maps already have a scene
+// lifetime.
+bool Mod_SlotmapInit(Slotmap* map, u32 elementSize, u32 capacity, bool sceneLifetime);
+// Returns the new element's key and writes its zeroed memory to *out, or returns SLOTMAP_KEY_NONE if the map is full.
+SlotmapKey Mod_SlotmapCreate(Slotmap* map, void** out);
+// Returns the element for a key, or NULL if the key isn't valid.
+void* Mod_SlotmapGet(Slotmap* map, SlotmapKey key);
+// Returns whether the key was valid.
+bool Mod_SlotmapErase(Slotmap* map, SlotmapKey key);
+// Steps through the live elements. Start with *cursor set to 0, and each call returns the next element and writes its
+// key to *key, or returns NULL once every element has been visited. Elements may be erased during iteration, but ones
+// created during it may be skipped.
+void* Mod_SlotmapNext(Slotmap* map, u32* cursor, SlotmapKey* key);
+// Copies the keys of up to `maxCount` live elements into `keys`, and their data into `elements` unless it's NULL.
+// Returns the number copied.
+u32 Mod_SlotmapSnapshot(Slotmap* map, SlotmapKey* keys, void* elements, u32 maxCount);
+// Erases every element in O(1).
+void Mod_SlotmapReset(Slotmap* map);
+void Mod_ResetSceneSlotmaps();
+
+#endif
@@ -2,17 +2,48 @@
 #include "modding.h"
 #include "recomputils.h"
 #include "recompconfig.h"
+#include "hook_stats.h"
+#include "config.h"
 #include "overlays/actors/ovl_En_M_Thunder/z_en_m_thunder.h"
 
-EnMThunder* bThis = NULL;
+// Scale of the GFS charge effect currently being drawn. Only set for the duration of EnMThunder_Draw, and only for the
+// GFS type, so the Matrix_RotateXS hook does nothing but a NULL check everywhere else.
+Vec3f* bChargeScale = NULL;
+
+Vec3f bGFSChargeScale;
 
 RECOMP_HOOK("EnMThunder_Draw") void EnMThunder_Draw_Init(Actor* thisx, PlayState* play2) {
-    bThis = (EnMThunder*)thisx;
+    HOOK_STATS_BEGIN(HOOK_STAT_EN_M_THUNDER_DRAW_INIT);
+
+    EnMThunder* this = (EnMThunder*)thisx;
+
+    if (this->type == ENMTHUNDER_TYPE_GREAT_FAIRYS_SWORD) {
+        bGFSChargeScale.x = 2.7143f * mGFSConfig.chargeScale;
+        bGFSChargeScale.y = 1.8333f * mGFSConfig.chargeScale;
+        bGFSChargeScale.z = 2.25f * mGFSConfig.chargeScale;
+        bChargeScale = &bGFSChargeScale;
+    }
+
+    HOOK_STATS_END(HOOK_STAT_EN_M_THUNDER_DRAW_INIT);
+}
+
+// Make sure the pointer doesn't outlive the draw if it returned before rotating.
+RECOMP_HOOK_RETURN("EnMThunder_Draw") void EnMThunder_Draw_Return() {
+    HOOK_STATS_BEGIN(HOOK_STAT_EN_M_THUNDER_DRAW_RETURN);
+
+    bChargeScale = NULL;
+
+    HOOK_STATS_END(HOOK_STAT_EN_M_THUNDER_DRAW_RETURN);
 }
 
 RECOMP_HOOK("Matrix_RotateXS") void Matrix_RotateXS_Init(s16 x, MatrixMode mode) {
-    if (bThis != NULL && bThis->type == ENMTHUNDER_TYPE_GREAT_FAIRYS_SWORD) {
-        Matrix_Scale(2.7143f, 1.8333f, 2.25f, MTXMODE_APPLY);
-        bThis = NULL;
+    HOOK_STATS_BEGIN(HOOK_STAT_MATRIX_ROTATE_XS);
+
+    if (bChargeScale != NULL) {
+        HOOK_STATS_COUNT(HOOK_STAT_CHARGE_SCALE);
+        Matrix_Scale(bChargeScale->x, bChargeScale->y, bChargeScale->z, MTXMODE_APPLY);
+        bChargeScale = NULL;
     }
-}
\ No newline at end of file
+
+    HOOK_STATS_END(HOOK_STAT_MATRIX_ROTATE_XS);
+}
@@ -1,28 +1,38 @@
 #include "eztr_api.h"
 #include "recomputils.h"
 #include "recompconfig.h"
+#include "hook_stats.h"
+#include "equip_state.h"
 
-extern bool mGFSEquipped;
+// Both versions of the smithy's reply are built once at init, so showing the message is just a copy.
+EZTR_MsgBuffer* bSmithyGFSMsg;
+EZTR_MsgBuffer* bSmithyDefaultMsg;
+
+EZTR_MsgBuffer* Mod_CreateSmithyMsg(char* content) {
+    EZTR_MsgBuffer* buf = EZTR_MsgBuffer_Create();
+
+    EZTR_MsgBuffer_WriteHeader(buf, EZTR_STANDARD_TEXT_BOX_I, 48, EZTR_ICON_NO_ICON, EZTR_NO_VALUE, EZTR_NO_VALUE,
+                               EZTR_NO_VALUE);
+    EZTR_MsgSContent_Copy(buf->data.content, content);
+
+    return buf;
+}
 
 EZTR_MSG_CALLBACK(GFS_change) {
+    HOOK_STATS_BEGIN(HOOK_STAT_GFS_CHANGE_MSG);
+
     if (mGFSEquipped) {
-        EZTR_MsgSContent_Sprintf(buf->data.content, "Excuse me, but just what do you" EZTR_CC_NEWLINE "think I'm supposed to do with" EZTR_CC_NEWLINE "that?! It doesn't even look like" EZTR_CC_NEWLINE "it's made of metal..." EZTR_CC_EVENT2 "" EZTR_CC_END "");
+        EZTR_MsgBuffer_Copy(buf, bSmithyGFSMsg->raw.schar);
     } else {
-        EZTR_MsgSContent_Sprintf(buf->data.content, "Sorry, but we do only swords and" EZTR_CC_NEWLINE "cutlery." EZTR_CC_EVENT2 "" EZTR_CC_END "");
+        EZTR_MsgBuffer_Copy(buf, bSmithyDefaultMsg->raw.schar);
     }
+
+    HOOK_STATS_END(HOOK_STAT_GFS_CHANGE_MSG);
 }
 
 EZTR_ON_INIT void Mod_MessageReplacement() {
-    EZTR_Basic_ReplaceText(
-        0x0C38,
-        EZTR_STANDARD_TEXT_BOX_I,
-        48,
-        EZTR_ICON_NO_ICON,
-        EZTR_NO_VALUE,
-        EZTR_NO_VALUE,
-        EZTR_NO_VALUE,
-        true,
-        "Sorry, but we do only swords and" EZTR_CC_NEWLINE "cutlery." EZTR_CC_EVENT2 "" EZTR_CC_END "",
-        GFS_change
-    );
-}
\ No newline at end of file
+    bSmithyGFSMsg = Mod_CreateSmithyMsg("Excuse me, but just what do you" EZTR_CC_NEWLINE "think I'm supposed to do with" EZTR_CC_NEWLINE "that?! It doesn't even look like" EZTR_CC_NEWLINE "it's made of metal..." EZTR_CC_EVENT2 "" EZTR_CC_END "");
+    bSmithyDefaultMsg = Mod_CreateSmithyMsg("Sorry, but we do only swords and" EZTR_CC_NEWLINE "cutlery." EZTR_CC_EVENT2 "" EZTR_CC_END "");
+
+    EZTR_Basic_ReplaceBuffer(0x0C38, bSmithyDefaultMsg, GFS_change);
+}
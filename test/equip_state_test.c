@@ -0,0 +1,363 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "global.h"
+#include "equip_state.h"
+#include "config.h"
+
+// Host driver for the GFS equip logic. Replays random sequences of the game events the mod hooks into (pausing to equip
+// the GFS, getting or losing swords, Epona, Fierce Deity, transformation masks, scene loads, config changes) by calling
+// the hooks the same way the game would, and checks the mod's invariants after every step. Build and run it with `make host-test`.
+// Usage: equip_state_test [sequences] [seed]
+
+#define ICON_ITEM_SIZE 0x1000
+#define SEQUENCE_LENGTH 32
+#define MAX_REPORTED_VIOLATIONS 10
+
+// Hooks and callbacks from the mod.
+extern void after_play_init(PlayState* this);
+extern void on_init();
+extern void KaleidoScope_UpdateItemCursor_Init(PlayState* play);
+extern void KaleidoScope_UpdateItemCursor_Return();
+extern void Player_GetCurMaskItemId_Init(PlayState* play);
+extern void Player_GetCurMaskItemId_Return();
+extern void Inventory_UpdateDeitySwordEquip_Return();
+extern void Interface_LoadItemIconImpl_Init(PlayState* play, u8 btn);
+extern void Interface_LoadItemIconImpl_Return();
+extern void Interface_Init_Init(PlayState* play);
+extern void func_80C10B0C_Init();
+extern void func_80C10B0C_Return();
+extern void Inventory_DeleteItem_Init(s16 item, s16 slot);
+extern void Interface_UpdateButtonsPart2_Return();
+
+typedef enum {
+    STEP_PAUSE_EQUIP,
+    STEP_GET_SWORD,
+    STEP_GET_GFS,
+    STEP_EPONA,
+    STEP_GFS_STOLEN,
+    STEP_SWORD_STOLEN,
+    STEP_FIERCE_DEITY,
+    STEP_TRANSFORM,
+    STEP_SCENE_LOAD,
+    STEP_TOGGLE_CONFIG,
+    STEP_MAX
+} Step;
+
+const char* bStepNames[STEP_MAX] = {
+    "pause equip", "get sword", "get GFS", "Epona", "GFS stolen", "sword stolen", "Fierce Deity", "transform",
+    "scene load", "toggle config",
+};
+
+SaveContext gSaveContext;
+u8 gPlayerFormItemRestrictions[PLAYER_FORM_MAX][114];
+
+PlayState bMockPlay;
+Player bMockPlayer;
+u8 bMockIconSegment[4 * ICON_ITEM_SIZE];
+bool bMockHasGFS;
+bool bMockOnEpona;
+// Form and mask the player should have after each step. The pause hooks change both temporarily.
+u8 bExpectedForm;
+s8 bExpectedMask;
+unsigned long bMockAllowOtherForms;
+// What Forms Use More Items would have put in the restriction table for the GFS.
+u8 bMockOtherModRestriction = true;
+
+u32 bRandomState;
+u64 bViolations = 0;
+u64 bInModViolations = 0;
+u64 bIconLoads = 0;
+// Icon loads for an empty button since the last invariant check.
+u64 bEmptyIconLoads = 0;
+
+u32 Test_Random() {
+    bRandomState ^= bRandomState << 13;
+    bRandomState ^= bRandomState >> 17;
+    bRandomState ^= bRandomState << 5;
+    return bRandomState;
+}
+
+void* recomp_alloc(unsigned long size) {
+    return malloc(size);
+}
+
+void recomp_free(void* memory) {
+    free(memory);
+}
+
+// The mod only prints when its own invariant checks fail.
+int recomp_printf(const char* fmt, ...) {
+    va_list args;
+    int ret = 0;
+
+    if (bInModViolations++ < MAX_REPORTED_VIOLATIONS) {
+        va_start(args, fmt);
+        ret = vprintf(fmt, args);
+        va_end(args);
+    }
+    return ret;
+}
+
+unsigned long recomp_get_config_u32(const char* key) {
+    if (strcmp(key, "allow_other_forms") == 0) {
+        return bMockAllowOtherForms;
+    }
+    return 0;
+}
+
+double recomp_get_config_double(const char* key) {
+    return 1.0;
+}
+
+// Runs the mod's hooks around filling the icon with the item's ID, so the driver can tell which icon the B button shows.
+// The game never loads an icon for an empty button, so those loads are counted as violations instead.
+void Interface_LoadItemIconImpl(PlayState* play, u8 btn) {
+    Interface_LoadItemIconImpl_Init(play, btn);
+    bIconLoads++;
+    if (GET_CUR_FORM_BTN_ITEM(btn) >= ITEM_F0) {
+        bEmptyIconLoads++;
+    } else {
+        memset((u8*)play->interfaceCtx.iconItemSegment + btn * ICON_ITEM_SIZE, GET_CUR_FORM_BTN_ITEM(btn),
+               ICON_ITEM_SIZE);
+    }
+    Interface_LoadItemIconImpl_Return();
+}
+
+u8 Test_SwordItem() {
+    u8 sword = GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD);
+    return sword == EQUIP_VALUE_SWORD_NONE ? ITEM_NONE : ITEM_SWORD_KOKIRI - 1 + sword;
+}
+
+bool Test_IsNormalSword(u8 item) {
+    return ITEM_SWORD_KOKIRI <= item && item <= ITEM_SWORD_GILDED;
+}
+
+// The game only reloads the B icon after changing it to an item.
+void Test_ReloadBButton() {
+    if (GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B) < ITEM_F0) {
+        Interface_LoadItemIconImpl(&bMockPlay, EQUIP_SLOT_B);
+    }
+}
+
+// Play_Init sets up the interface, which reallocates the icon segment and loads the B icon, before after_play_init runs.
+void Test_SceneLoad() {
+    Interface_Init_Init(&bMockPlay);
+    memset(bMockIconSegment, 0xEE, sizeof(bMockIconSegment));
+    Test_ReloadBButton();
+    after_play_init(&bMockPlay);
+}
+
+void Test_StartSequence() {
+    bzero(&gSaveContext, sizeof(gSaveContext));
+    GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD) = 1 + Test_Random() % 3;
+    BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = Test_SwordItem();
+    BUTTON_ITEM_EQUIP(PLAYER_FORM_GORON, EQUIP_SLOT_B) = ITEM_NONE;
+    BUTTON_ITEM_EQUIP(PLAYER_FORM_ZORA, EQUIP_SLOT_B) = ITEM_NONE;
+    BUTTON_ITEM_EQUIP(PLAYER_FORM_DEKU, EQUIP_SLOT_B) = ITEM_DEKU_NUT;
+    gSaveContext.save.playerForm = PLAYER_FORM_HUMAN;
+    bMockPlayer.currentMask = bExpectedMask = PLAYER_MASK_NONE;
+    bExpectedForm = PLAYER_FORM_HUMAN;
+    bMockHasGFS = Test_Random() & 1;
+    bMockOnEpona = false;
+    mGFSEquipped = false;
+    Test_SceneLoad();
+}
+
+void Test_Step(Step step) {
+    bool fierceDeity = GET_PLAYER_FORM == PLAYER_FORM_FIERCE_DEITY;
+    bool human = GET_PLAYER_FORM == PLAYER_FORM_HUMAN;
+
+    switch (step) {
+        case STEP_PAUSE_EQUIP:
+            if (bMockHasGFS && !bMockOnEpona) {
+                bMockPlayer.currentMask = bExpectedMask = 1 + Test_Random() % 4;
+                bMockPlay.pauseCtx.cursorItem[PAUSE_ITEM] = ITEM_SWORD_GREAT_FAIRY;
+                KaleidoScope_UpdateItemCursor_Init(&bMockPlay);
+                Player_GetCurMaskItemId_Init(&bMockPlay);
+                Player_GetCurMaskItemId_Return();
+                bMockPlay.pauseCtx.mainState = PAUSE_MAIN_STATE_EQUIP_ITEM;
+                bMockPlay.pauseCtx.equipTargetItem = ITEM_SWORD_GREAT_FAIRY;
+                KaleidoScope_UpdateItemCursor_Return();
+            }
+            break;
+
+        case STEP_GET_SWORD:
+            if (human && !bMockOnEpona && GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD) < 3) {
+                GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD)++;
+                BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = Test_SwordItem();
+                Test_ReloadBButton();
+            }
+            break;
+
+        case STEP_GET_GFS:
+            bMockHasGFS = true;
+            break;
+
+        case STEP_EPONA:
+            if (human) {
+                bMockOnEpona = !bMockOnEpona;
+                // Interface_UpdateButtonsPart2 swaps the B button when mounting and dismounting.
+                BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = bMockOnEpona ? ITEM_BOW : Test_SwordItem();
+                Test_ReloadBButton();
+                Interface_UpdateButtonsPart2_Return();
+            }
+            break;
+
+        case STEP_GFS_STOLEN:
+            if (!fierceDeity && !bMockOnEpona && bMockHasGFS) {
+                Inventory_DeleteItem_Init(ITEM_SWORD_GREAT_FAIRY, 0);
+                bMockHasGFS = false;
+            }
+            break;
+
+        case STEP_SWORD_STOLEN:
+            if (human && !bMockOnEpona && GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD) != EQUIP_VALUE_SWORD_NONE &&
+                GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD) < 3) {
+                func_80C10B0C_Init();
+                // The game clears the B button without reloading its icon, whatever was on it.
+                GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD) = EQUIP_VALUE_SWORD_NONE;
+                BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_NONE;
+                func_80C10B0C_Return();
+            }
+            break;
+
+        case STEP_FIERCE_DEITY:
+            // Mirrors Inventory_UpdateDeitySwordEquip.
+            if ((human || fierceDeity) && !bMockOnEpona) {
+                if (fierceDeity) {
+                    gSaveContext.save.playerForm = bExpectedForm = PLAYER_FORM_HUMAN;
+                    if (BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) == ITEM_SWORD_DEITY) {
+                        BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = Test_SwordItem();
+                    }
+                } else {
+                    gSaveContext.save.playerForm = bExpectedForm = PLAYER_FORM_FIERCE_DEITY;
+                    BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B) = ITEM_SWORD_DEITY;
+                }
+                Test_ReloadBButton();
+                Inventory_UpdateDeitySwordEquip_Return();
+            }
+            break;
+
+        case STEP_TRANSFORM:
+            // Goron, Zora and Deku Link have their own B button, which the game loads the icon for on the change.
+            if (human && !bMockOnEpona) {
+                gSaveContext.save.playerForm = bExpectedForm = PLAYER_FORM_GORON + Test_Random() % 3;
+                Test_ReloadBButton();
+            } else if (!human && !fierceDeity) {
+                gSaveContext.save.playerForm = bExpectedForm = PLAYER_FORM_HUMAN;
+                Test_ReloadBButton();
+            }
+            break;
+
+        case STEP_SCENE_LOAD:
+            Test_SceneLoad();
+            break;
+
+        case STEP_TOGGLE_CONFIG:
+            bMockAllowOtherForms = !bMockAllowOtherForms;
+            Mod_RefreshConfig();
+            break;
+
+        default:
+            break;
+    }
+}
+
+void Test_Violation(Step step, const char* what) {
+    if (bViolations++ < MAX_REPORTED_VIOLATIONS) {
+        printf("after %s: %s (equipped %d, B button 0x%02X, form B button 0x%02X, sword %d, form %d, on Epona %d)\n",
+               bStepNames[step], what, mGFSEquipped, BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B),
+               GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B), GET_CUR_EQUIP_VALUE(EQUIP_TYPE_SWORD), GET_PLAYER_FORM, bMockOnEpona);
+    }
+}
+
+void Test_CheckInvariants(Step step) {
+    u8 bButtonItem = BUTTON_ITEM_EQUIP(0, EQUIP_SLOT_B);
+    u8 shownItem = GET_CUR_FORM_BTN_ITEM(EQUIP_SLOT_B);
+    u8 expectedRestriction = bMockAllowOtherForms ? bMockOtherModRestriction : false;
+    u8 expectedItem;
+
+    if (bMockOnEpona) {
+        expectedItem = ITEM_BOW;
+    } else if (GET_PLAYER_FORM == PLAYER_FORM_FIERCE_DEITY) {
+        expectedItem = ITEM_SWORD_DEITY;
+    } else {
+        expectedItem = mGFSEquipped ? ITEM_SWORD_GREAT_FAIRY : Test_SwordItem();
+    }
+
+    if (mGFSEquipped && Test_IsNormalSword(bButtonItem)) {
+        Test_Violation(step, "normal sword on B while the GFS is equipped");
+    }
+    if (!mGFSEquipped && bButtonItem == ITEM_SWORD_GREAT_FAIRY) {
+        Test_Violation(step, "GFS on B while it isn't equipped");
+    }
+    if (mGFSEquipped && !bMockHasGFS) {
+        Test_Violation(step, "GFS equipped without being in the inventory");
+    }
+    if (bButtonItem != expectedItem) {
+        Test_Violation(step, "B button doesn't hold the item it should");
+    }
+    // The icon is for the current form's B button. An empty button isn't drawn, so whatever its icon holds doesn't matter.
+    if (shownItem < ITEM_F0 && (bMockIconSegment[EQUIP_SLOT_B * ICON_ITEM_SIZE] != shownItem ||
+        bMockIconSegment[EQUIP_SLOT_B * ICON_ITEM_SIZE + ICON_ITEM_SIZE - 1] != shownItem)) {
+        Test_Violation(step, "B button icon doesn't match its item");
+    }
+    if (bEmptyIconLoads != 0) {
+        Test_Violation(step, "icon loaded for an empty B button");
+        bEmptyIconLoads = 0;
+    }
+    if (GET_PLAYER_FORM != bExpectedForm || bMockPlayer.currentMask != bExpectedMask) {
+        Test_Violation(step, "form or mask not restored");
+    }
+    for (s32 i = PLAYER_FORM_FIERCE_DEITY; i <= PLAYER_FORM_DEKU; i++) {
+        if (gPlayerFormItemRestrictions[i][ITEM_SWORD_GREAT_FAIRY] != expectedRestriction) {
+            Test_Violation(step, "GFS form restriction doesn't match the config");
+            break;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    u32 sequences = argc > 1 ? strtoul(argv[1], NULL, 0) : 200000;
+    u32 seed = argc > 2 ? strtoul(argv[2], NULL, 0) : (u32)time(NULL);
+    u64 transitions = 0;
+    struct timespec start;
+    struct timespec end;
+
+    bRandomState = seed != 0 ? seed : 1;
+    bMockPlay.interfaceCtx.iconItemSegment = bMockIconSegment;
+    bMockPlay.player = &bMockPlayer;
+
+    for (s32 i = PLAYER_FORM_FIERCE_DEITY; i <= PLAYER_FORM_DEKU; i++) {
+        gPlayerFormItemRestrictions[i][ITEM_SWORD_GREAT_FAIRY] = bMockOtherModRestriction;
+    }
+    on_init();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (u32 i = 0; i < sequences; i++) {
+        Test_StartSequence();
+
+        for (s32 j = 0; j < SEQUENCE_LENGTH; j++) {
+            Step step = Test_Random() % STEP_MAX;
+
+            Test_Step(step);
+            Test_CheckInvariants(step);
+            transitions++;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double nsec = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+    printf("seed %u: %llu transitions in %u sequences, %.1f ns/transition, %llu icon loads, %llu violations, "
+           "%llu reported by the mod\n",
+           seed, (unsigned long long)transitions, sequences, nsec / transitions, (unsigned long long)bIconLoads,
+           (unsigned long long)bViolations, (unsigned long long)bInModViolations);
+
+    return (bViolations != 0 || bInModViolations != 0) ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+#ifndef __GLOBAL_H__
+#define __GLOBAL_H__
+
+// Stand-in for the decomp's global.h, for building the equip logic on the host. Only covers what the mod's equip code
+// touches, with the same names and item values as the game.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+typedef int8_t s8;
+typedef uint8_t u8;
+typedef int16_t s16;
+typedef uint16_t u16;
+typedef int32_t s32;
+typedef uint32_t u32;
+typedef int64_t s64;
+typedef uint64_t u64;
+typedef float f32;
+typedef u64 OSTime;
+
+typedef struct {
+    u8 r, g, b;
+} Color_RGB8;
+
+#define ARRAY_COUNT(arr) (s32)(sizeof(arr) / sizeof(arr[0]))
+#define ALIGN8(val) (((val) + 7) & ~7)
+#define Lib_MemCpy memcpy
+
+#define ITEM_BOW 0x01
+#define ITEM_DEKU_NUT 0x09
+#define ITEM_SWORD_GREAT_FAIRY 0x10
+#define ITEM_SWORD_KOKIRI 0x4D
+#define ITEM_SWORD_RAZOR 0x4E
+#define ITEM_SWORD_GILDED 0x4F
+#define ITEM_SWORD_DEITY 0x50
+#define ITEM_F0 0xF0
+#define ITEM_NONE 0xFF
+
+#define EQUIP_TYPE_SWORD 0
+#define EQUIP_TYPE_MAX 2
+#define EQUIP_VALUE_SWORD_NONE 0
+#define EQUIP_SLOT_B 0
+
+typedef enum {
+    PLAYER_FORM_FIERCE_DEITY,
+    PLAYER_FORM_GORON,
+    PLAYER_FORM_ZORA,
+    PLAYER_FORM_DEKU,
+    PLAYER_FORM_HUMAN,
+    PLAYER_FORM_MAX
+} PlayerTransformation;
+
+#define PLAYER_MASK_NONE 0
+#define PLAYER_MASK_MAX 25
+
+#define PAUSE_ITEM 0
+#define PAUSE_MAIN_STATE_IDLE 0
+#define PAUSE_MAIN_STATE_EQUIP_ITEM 3
+
+typedef struct {
+    u8 buttonItems[4][4];
+    u8 equipment[EQUIP_TYPE_MAX];
+} ItemEquips;
+
+typedef struct {
+    struct {
+        struct {
+            ItemEquips equips;
+        } saveInfo;
+        u8 playerForm;
+    } save;
+} SaveContext;
+
+extern SaveContext gSaveContext;
+
+#define GET_PLAYER_FORM (gSaveContext.save.playerForm)
+#define BUTTON_ITEM_EQUIP(form, button) (gSaveContext.save.saveInfo.equips.buttonItems[form][button])
+// Human and Fierce Deity Link share the first set of buttons, and Goron, Zora and Deku Link each have their own B button.
+#define CUR_FORM ((GET_PLAYER_FORM == PLAYER_FORM_HUMAN) ? 0 : GET_PLAYER_FORM)
+#define GET_CUR_FORM_BTN_ITEM(button) \
+    ((u8)(((button) == EQUIP_SLOT_B) ? BUTTON_ITEM_EQUIP(CUR_FORM, button) : BUTTON_ITEM_EQUIP(0, button)))
+#define GET_CUR_EQUIP_VALUE(equip) (gSaveContext.save.saveInfo.equips.equipment[equip])
+
+typedef struct {
+    s8 currentMask;
+} Player;
+
+typedef struct {
+    u16 mainState;
+    u16 cursorItem[5];
+    u16 equipTargetItem;
+    s16 alpha;
+} PauseContext;
+
+typedef struct {
+    void* iconItemSegment;
+} InterfaceContext;
+
+typedef struct PlayState {
+    PauseContext pauseCtx;
+    InterfaceContext interfaceCtx;
+    Player* player;
+} PlayState;
+
+#define GET_PLAYER(play) ((play)->player)
+
+void Interface_LoadItemIconImpl(PlayState* play, u8 btn);
+
+#endif
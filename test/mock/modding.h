@@ -0,0 +1,11 @@
+#ifndef __MODDING_H__
+#define __MODDING_H__
+
+// Hooks and callbacks become plain functions for the driver to call.
+#define RECOMP_IMPORT(mod, func) func;
+#define RECOMP_EXPORT
+#define RECOMP_CALLBACK(mod, event)
+#define RECOMP_HOOK(func)
+#define RECOMP_HOOK_RETURN(func)
+
+#endif
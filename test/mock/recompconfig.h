@@ -0,0 +1,9 @@
+#ifndef __RECOMPCONFIG_H__
+#define __RECOMPCONFIG_H__
+
+#include "modding.h"
+
+RECOMP_IMPORT("*", unsigned long recomp_get_config_u32(const char* key));
+RECOMP_IMPORT("*", double recomp_get_config_double(const char* key));
+
+#endif